@@ -12,6 +12,7 @@ copy build\snake_game.exe Release\
 copy "C:\msys64\mingw64\bin\Qt5Core.dll" Release\
 copy "C:\msys64\mingw64\bin\Qt5Gui.dll" Release\
 copy "C:\msys64\mingw64\bin\Qt5Widgets.dll" Release\
+copy "C:\msys64\mingw64\bin\Qt5Concurrent.dll" Release\
 
 :: Системные DLL Mingw64
 copy "C:\msys64\mingw64\bin\libgcc_s_seh-1.dll" Release\
@@ -25,8 +26,10 @@ copy "C:\msys64\mingw64\bin\libpcre2-16-0.dll" Release\
 :: Плагины (только необходимые)
 xcopy "C:\msys64\mingw64\share\qt5\plugins\platforms" Release\plugins\platforms /E /I /Y
 
-:: Ресурсы игры
-xcopy "src\pic" Release\src\pic /E /I /Y
+:: Декодер JPEG для изображений из встроенных ресурсов
+mkdir Release\plugins\imageformats
+copy "C:\msys64\mingw64\share\qt5\plugins\imageformats\qjpeg.dll" Release\plugins\imageformats\
+copy "C:\msys64\mingw64\bin\libjpeg-8.dll" Release\
 
 :: Файл конфигурации Qt
 echo [Paths] > Release\qt.conf
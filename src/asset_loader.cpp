@@ -0,0 +1,51 @@
+#include "asset_loader.h"
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <QtConcurrent/QtConcurrentRun>
+
+QImage AssetLoader::loadScaled(const QString &path, const QSize &size)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QImage();
+    }
+    const QByteArray data = file.readAll();
+
+    // Ключ кэша: хэш исходных данных и целевой размер
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(data);
+    hash.addData(QByteArray::number(size.width()) + 'x' + QByteArray::number(size.height()));
+
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    const QString cachePath = cacheDir + "/" + QString::fromLatin1(hash.result().toHex()) + ".png";
+
+    QImage image(cachePath);
+    if (!image.isNull()) {
+        return image;
+    }
+
+    image = QImage::fromData(data);
+    if (image.isNull()) {
+        return image;
+    }
+
+    image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+
+    // Запись через QSaveFile атомарна; ошибка записи кэша не критична
+    if (!cacheDir.isEmpty() && QDir().mkpath(cacheDir)) {
+        QSaveFile cacheFile(cachePath);
+        if (cacheFile.open(QIODevice::WriteOnly) && image.save(&cacheFile, "PNG")) {
+            cacheFile.commit();
+        }
+    }
+
+    return image;
+}
+
+QFuture<QImage> AssetLoader::loadScaledAsync(const QString &path, const QSize &size)
+{
+    return QtConcurrent::run(&AssetLoader::loadScaled, path, size);
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <QImage>
+#include <QFuture>
+#include <QSize>
+#include <QString>
+
+/**
+ * @class AssetLoader
+ * @brief Загрузка изображений из ресурсов с кэшем уменьшенных копий на диске
+ *
+ * Декодирование JPEG и масштабирование выполняются один раз: результат
+ * сохраняется в каталог кэша под именем, составленным из хэша исходных
+ * данных и целевого размера. При изменении ресурса кэш устаревает сам.
+ */
+class AssetLoader
+{
+public:
+    /**
+     * @brief Загружает изображение, уменьшенное до заданного размера
+     * @param path Путь к изображению (обычно ресурс вида ":/pic/...")
+     * @param size Целевой размер с сохранением пропорций
+     * @return Изображение или пустой QImage при ошибке
+     */
+    static QImage loadScaled(const QString &path, const QSize &size);
+
+    /**
+     * @brief Запускает loadScaled() в пуле потоков QtConcurrent
+     */
+    static QFuture<QImage> loadScaledAsync(const QString &path, const QSize &size);
+};
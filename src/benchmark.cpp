@@ -0,0 +1,98 @@
+#include "benchmark.h"
+#include "snake_game.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QImage>
+#include <QStringList>
+#include <algorithm>
+#include <cstdio>
+
+namespace {
+
+void printStats(const char *name, QVector<qint64> &samples)
+{
+    std::printf("%-6s p50 %8.1f us   p99 %8.1f us   max %8.1f us\n", name,
+                percentileUs(samples, 0.50),
+                percentileUs(samples, 0.99),
+                percentileUs(samples, 1.0));
+}
+
+} // namespace
+
+void applyGameOptions(SnakeGame &game, const QStringList &arguments)
+{
+    // Выбор программного бэкенда отрисовки при запуске
+    if (arguments.contains("--software-render")) {
+        game.setRenderBackend(SnakeGame::RenderBackend::Software);
+    }
+
+    // Отрисовка тела единым сглаженным контуром
+    if (arguments.contains("--smooth-body")) {
+        game.setBodyStyle(SnakeGame::BodyStyle::SmoothPath);
+    }
+
+    // Детерминированная целочисленная симуляция
+    if (arguments.contains("--fixed-point")) {
+        game.setFixedPointMath(true);
+    }
+}
+
+void runTimedTicks(SnakeGame &game, QImage &frame, int count, FrameTimings &timings)
+{
+    QElapsedTimer timer;
+
+    for (int i = 0; i < count; i++) {
+        timer.start();
+        game.step();
+        timings.ticks.append(timer.nsecsElapsed());
+        timings.maxLength = qMax(timings.maxLength, game.snakeLength());
+
+        timer.start();
+        game.render(&frame);
+        timings.frames.append(timer.nsecsElapsed());
+
+        QCoreApplication::processEvents();
+    }
+}
+
+double percentileUs(QVector<qint64> &samples, double percentile)
+{
+    if (samples.isEmpty()) return 0;
+    std::sort(samples.begin(), samples.end());
+    const int index = qMin(samples.size() - 1, int(samples.size() * percentile));
+    return samples[index] / 1000.0;
+}
+
+int runBenchmark(SnakeGame &game, int ticks)
+{
+    const quint32 seed = 1;
+
+    QImage frame(game.size(), QImage::Format_ARGB32_Premultiplied);
+    FrameTimings timings;
+    timings.ticks.reserve(ticks);
+    timings.frames.reserve(ticks);
+
+    game.startHeadless(seed);
+
+    QElapsedTimer total;
+    total.start();
+
+    runTimedTicks(game, frame, ticks, timings);
+
+    const double seconds = total.nsecsElapsed() / 1e9;
+    std::printf("benchmark: %d ticks in %.2f s (%.0f ticks/s)\n",
+                ticks, seconds, seconds > 0 ? ticks / seconds : 0.0);
+    std::printf("length: final %d max %d, restarts %d\n",
+                game.snakeLength(), timings.maxLength, game.headlessRestarts());
+    printStats("tick", timings.ticks);
+    printStats("frame", timings.frames);
+
+    // Итоговое состояние: в режиме --fixed-point совпадает у любых сборок
+    const SnakeGame::StateDigest digest = game.stateDigest();
+    std::printf("digest: score %d length %d head %08x,%08x angle %08x body %016llx\n",
+                digest.score, digest.length,
+                quint32(digest.headX), quint32(digest.headY), digest.angle,
+                static_cast<unsigned long long>(digest.bodyHash));
+
+    return 0;
+}
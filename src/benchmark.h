@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QVector>
+
+class QImage;
+class QStringList;
+class SnakeGame;
+
+/// Времена тактов и кадров прогона в наносекундах
+struct FrameTimings {
+    QVector<qint64> ticks;
+    QVector<qint64> frames;
+    int maxLength = 0;      ///< Наибольшая длина змейки за прогон
+};
+
+/**
+ * @brief Применяет параметры игры из командной строки
+ *
+ * --software-render, --smooth-body и --fixed-point; общие для игры,
+ * бенчмарка и длительного прогона.
+ */
+void applyGameOptions(SnakeGame &game, const QStringList &arguments);
+
+/**
+ * @brief Выполняет count тактов с отрисовкой в frame и дописывает их время в timings
+ *
+ * timings.maxLength обновляется длиной змейки после каждого такта.
+ *
+ * Между тактами обрабатываются отложенные события, как в обычном цикле
+ * событий; это время не учитывается.
+ */
+void runTimedTicks(SnakeGame &game, QImage &frame, int count, FrameTimings &timings);
+
+/**
+ * @brief Перцентиль выборки в микросекундах (выборка сортируется на месте)
+ */
+double percentileUs(QVector<qint64> &samples, double percentile);
+
+/**
+ * @brief Безголовый прогон игры с замером времени тактов и кадров
+ * @param game Игровой виджет (может быть не показан на экране)
+ * @param ticks Количество тактов
+ * @return Код завершения процесса
+ *
+ * Змейкой управляет автопилот с фиксированным зерном, поэтому прогоны
+ * повторяемы. Используется для сравнения сборок и как обучающий прогон PGO.
+ * Печатаются итоговая и наибольшая длина змейки и число перезапусков, чтобы
+ * прогон на короткой змейке был виден. В конце печатается сводка состояния (SnakeGame::stateDigest()): с
+ * --fixed-point она должна совпадать у сборок с любыми флагами.
+ */
+int runBenchmark(SnakeGame &game, int ticks);
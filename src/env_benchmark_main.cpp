@@ -0,0 +1,71 @@
+#include "snake_env.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QStringList>
+#include <cstdio>
+
+// Значение целого параметра командной строки "--name value"
+static int argumentValue(const QStringList &arguments, const QString &name, int defaultValue)
+{
+    const int index = arguments.indexOf(name);
+    if (index < 0 || index + 1 >= arguments.size()) return defaultValue;
+
+    bool ok = false;
+    const int value = arguments[index + 1].toInt(&ok);
+    return ok && value > 0 ? value : defaultValue;
+}
+
+/**
+ * @brief Замер пропускной способности пакетного окружения SnakeEnvBatch
+ *
+ * Для каждого K из набора выполняет --steps шагов со случайными действиями
+ * и печатает число шагов отдельных игр в секунду.
+ *
+ * Параметры:
+ *   --steps N         количество шагов пакета (по умолчанию 2000)
+ *   --envs K          замерить только K игр (иначе 64, 256, 1024, 4096)
+ *   --grid            наблюдение сеткой занятости вместо признаков
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList arguments = app.arguments();
+
+    const int steps = argumentValue(arguments, "--steps", 2000);
+    const int onlyEnvs = argumentValue(arguments, "--envs", 0);
+    const QVector<int> envCounts = onlyEnvs > 0 ? QVector<int>{onlyEnvs}
+                                                : QVector<int>{64, 256, 1024, 4096};
+
+    for (int numEnvs : envCounts) {
+        SnakeEnvBatch::Config config;
+        config.numEnvs = numEnvs;
+        config.observation = arguments.contains("--grid") ? SnakeEnvBatch::Observation::Grid
+                                                          : SnakeEnvBatch::Observation::Features;
+        SnakeEnvBatch env(config);
+        if (!env.isValid()) {
+            std::fprintf(stderr, "env benchmark: %s\n", qPrintable(env.errorString()));
+            return 1;
+        }
+
+        // Повторяемые случайные действия (LCG), чтобы генерация не мешала замеру
+        quint64 random = 1;
+        QElapsedTimer timer;
+        timer.start();
+
+        for (int step = 0; step < steps; step++) {
+            quint8 *actions = env.actions();
+            for (int i = 0; i < numEnvs; i++) {
+                random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+                actions[i] = quint8(random >> 60);
+            }
+            env.step();
+        }
+
+        const double seconds = timer.nsecsElapsed() / 1e9;
+        const double rate = seconds > 0 ? double(steps) * numEnvs / seconds : 0.0;
+        std::printf("env benchmark: K=%-5d %d steps in %.2f s (%.2f M env-steps/s)\n",
+                    numEnvs, steps, seconds, rate / 1e6);
+    }
+
+    return 0;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QtGlobal>
+
+/**
+ * @brief Целочисленная математика для детерминированной симуляции
+ *
+ * Координаты и скорость хранятся в формате Q16.16, угол - как доля полного
+ * оборота (2^32 = 360°), синус и косинус берутся из встроенной таблицы.
+ * Все операции целочисленные, поэтому результат не зависит от компилятора,
+ * флагов оптимизации и процессора.
+ */
+namespace FixedMath {
+
+using Fixed = qint32;                               ///< Число в формате Q16.16
+using Angle = quint32;                              ///< Угол, полный оборот = 2^32
+
+const int FRACTION_BITS = 16;
+const Fixed ONE = 1 << FRACTION_BITS;
+
+/// Перевод константы или точно представимого значения в Q16.16
+inline Fixed fromReal(qreal value) { return Fixed(qRound(value * ONE)); }
+/// Перевод в qreal (всегда точный)
+inline qreal toReal(Fixed value) { return value / qreal(ONE); }
+/// Умножение Q16.16
+inline Fixed mul(Fixed a, Fixed b) { return Fixed((qint64(a) * b) >> FRACTION_BITS); }
+
+/// Перевод угла в радианах (для констант) и обратно
+Angle angleFromRadians(qreal radians);
+qreal angleToRadians(Angle angle);
+
+/// Синус и косинус в Q16.16 по таблице с линейной интерполяцией
+Fixed sin(Angle angle);
+Fixed cos(Angle angle);
+
+/**
+ * @brief Проверяет, ближе ли точка к отрезку [from, to], чем distance
+ *
+ * Целочисленный аналог проверки капсулы; все аргументы в Q16.16.
+ */
+bool segmentCloserThan(Fixed px, Fixed py,
+                       Fixed fromX, Fixed fromY,
+                       Fixed toX, Fixed toY,
+                       Fixed distance);
+
+} // namespace FixedMath
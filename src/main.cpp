@@ -1,25 +1,112 @@
 #include "snake_game.h"
 #include "snake_menu.h"
+#include "benchmark.h"
 #include <QApplication>
 #include <QStackedWidget>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTimer>
+#include <QDebug>
+#include <functional>
+
+// Фильтр событий, вызывающий обработчик после первой отрисовки виджета
+class FirstFrameFilter : public QObject
+{
+public:
+    FirstFrameFilter(QWidget *widget, std::function<void()> callback)
+        : QObject(widget), m_callback(std::move(callback))
+    {
+        widget->installEventFilter(this);
+    }
+
+    bool eventFilter(QObject *watched, QEvent *event) override
+    {
+        if (event->type() == QEvent::Paint) {
+            // Обработчик откладывается до завершения отрисовки кадра
+            watched->removeEventFilter(this);
+            QTimer::singleShot(0, m_callback);
+            deleteLater();
+        }
+        return false;
+    }
+
+private:
+    std::function<void()> m_callback;
+};
 
 int main(int argc, char *argv[])
 {
+    QElapsedTimer startupTimer;
+    startupTimer.start();
+    
     QApplication app(argc, argv);
     
+    const bool traceStartup = app.arguments().contains("--trace-startup");
+    
+    // Безголовый бенчмарк: --benchmark [число тактов]
+    const int benchmarkIndex = app.arguments().indexOf("--benchmark");
+    if (benchmarkIndex >= 0) {
+        // Без числа (следующий аргумент - флаг или отсутствует) берется значение по умолчанию
+        bool ok = false;
+        int ticks = app.arguments().value(benchmarkIndex + 1).toInt(&ok);
+        if (!ok) {
+            ticks = 10000;
+        } else if (ticks <= 0) {
+            qWarning("usage: snake_game --benchmark [ticks > 0] [--software-render] [--smooth-body] [--fixed-point]");
+            return 1;
+        }
+    
+        SnakeGame game;
+        applyGameOptions(game, app.arguments());
+        return runBenchmark(game, ticks);
+    }
+    
+    // Единая таблица стилей для всех виджетов
+    QFile styleFile(":/style.qss");
+    if (styleFile.open(QIODevice::ReadOnly)) {
+        app.setStyleSheet(QString::fromUtf8(styleFile.readAll()));
+    }
+    
     QStackedWidget *stackedWidget = new QStackedWidget;
     stackedWidget->setFixedSize(600, 600);
     
     SnakeMenu *menu = new SnakeMenu;
-    SnakeGame *game = new SnakeGame;
     
     stackedWidget->addWidget(menu);
-    stackedWidget->addWidget(game);
     stackedWidget->setCurrentWidget(menu);
     
     stackedWidget->setWindowTitle("Snake Game");
     
-    QObject::connect(menu, &SnakeMenu::startGameRequested, [=]() {
+    // Игровой виджет создается при первом запросе или заранее после показа меню
+    SnakeGame *game = nullptr;
+    auto ensureGame = [&]() {
+        if (game) return;
+    
+        const qint64 createStart = startupTimer.elapsed();
+        game = new SnakeGame;
+        applyGameOptions(*game, app.arguments());
+    
+        stackedWidget->addWidget(game);
+    
+        QObject::connect(game, &SnakeGame::escapePressed, [=]() {
+            if (game->isGameActive()) {
+                game->pauseGame();
+            }
+            stackedWidget->setCurrentWidget(menu);
+        });
+    
+        QObject::connect(game, &SnakeGame::gameOver, [=]() {
+            // Дополнительная логика при завершении игры
+        });
+    
+        if (traceStartup) {
+            qInfo("startup: game widget created in %lld ms",
+                  startupTimer.elapsed() - createStart);
+        }
+    };
+    
+    QObject::connect(menu, &SnakeMenu::startGameRequested, [&]() {
+        ensureGame();
         game->initGame();
         stackedWidget->setCurrentWidget(game);
         game->setFocus();
@@ -27,18 +114,14 @@ int main(int argc, char *argv[])
     
     QObject::connect(menu, &SnakeMenu::quitGameRequested, &app, &QApplication::quit);
     
-    QObject::connect(game, &SnakeGame::escapePressed, [=]() {
-        if (game->isGameActive()) {
-            game->pauseGame();
+    new FirstFrameFilter(menu, [&]() {
+        if (traceStartup) {
+            qInfo("startup: first frame after %lld ms", startupTimer.elapsed());
         }
-        stackedWidget->setCurrentWidget(menu);
-    });
-    
-    QObject::connect(game, &SnakeGame::gameOver, [=]() {
-        // Дополнительная логика при завершении игры
+        ensureGame();
     });
     
     stackedWidget->show();
     
     return app.exec();
-}
\ No newline at end of file
+}
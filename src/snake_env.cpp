@@ -0,0 +1,509 @@
+#include "snake_env.h"
+#include <QtConcurrent/QtConcurrentMap>
+#include <QElapsedTimer>
+#include <QThread>
+#include <cmath>
+#include <cstring>
+#include <new>
+
+namespace {
+
+// Игровые константы (те же, что в SnakeGame)
+const float DOT_SIZE = 10.0f;
+const float MAX_SPEED = 12.0f;
+const float ACCELERATION = 0.3f;
+const float TURN_SPEED = 0.08f;
+const float SEGMENT_DISTANCE = 8.0f;
+const float TWO_PI = 6.28318530717958647692f;
+
+const float SELF_HIT_DISTANCE = DOT_SIZE * 0.8f;
+const float APPLE_HIT_DISTANCE = DOT_SIZE;
+const float APPLE_CLEARANCE = DOT_SIZE * 2;
+const int APPLE_ATTEMPTS = 64;
+
+const int INITIAL_LENGTH = 3;
+const int GROWTH_BUFFER = 3;
+
+// Минимум игр в задаче пула: шаг игры занимает доли микросекунды,
+// а постановка задачи в пул - единицы микросекунд
+const int MIN_ENVS_PER_CHUNK = 64;
+
+// Ожидание запроса в serve(): сначала уступка потока, затем короткий сон
+const int SERVE_SPIN_LIMIT = 1000;
+const unsigned long SERVE_SLEEP_US = 50;
+
+// Выравнивание массивов в общем буфере по строке кэша
+quint32 alignOffset(quint32 offset)
+{
+    return (offset + 63) & ~quint32(63);
+}
+
+// Телепортация координаты через границу поля (как SnakeGame::handleBoundaryTeleportation)
+float teleport(float value, float fieldSize)
+{
+    if (value < -DOT_SIZE * 3) return fieldSize + DOT_SIZE * 2;
+    if (value > fieldSize + DOT_SIZE * 3) return -DOT_SIZE * 2;
+    return value;
+}
+
+// Квадрат расстояния от точки до отрезка [from, to] (как distanceToSegment в SnakeGame)
+float distanceToSegmentSquared(float x, float y, float fromX, float fromY, float toX, float toY)
+{
+    const float segmentX = toX - fromX;
+    const float segmentY = toY - fromY;
+    const float lengthSquared = segmentX * segmentX + segmentY * segmentY;
+
+    float t = 0;
+    if (lengthSquared > 0) {
+        t = qBound(0.0f, ((x - fromX) * segmentX + (y - fromY) * segmentY) / lengthSquared, 1.0f);
+    }
+
+    const float dx = x - (fromX + segmentX * t);
+    const float dy = y - (fromY + segmentY * t);
+    return dx * dx + dy * dy;
+}
+
+} // namespace
+
+SnakeEnvBatch::SnakeEnvBatch(const Config &config) :
+    m_config(config),
+    m_header(nullptr),
+    m_actions(nullptr),
+    m_observations(nullptr),
+    m_rewards(nullptr),
+    m_dones(nullptr)
+{
+    m_config.numEnvs = qMax(1, m_config.numEnvs);
+    m_config.gridSize = qMax(1, m_config.gridSize);
+    m_config.maxLength = qMax(INITIAL_LENGTH + GROWTH_BUFFER + 1, m_config.maxLength);
+
+    const quint32 count = quint32(m_config.numEnvs);
+    const quint32 observationBytes = m_config.observation == Observation::Grid
+        ? quint32(m_config.gridSize * m_config.gridSize)
+        : quint32(FEATURE_COUNT * sizeof(float));
+
+    // Раскладка общего буфера: заголовок | действия | наблюдения | награды | флаги
+    const quint32 actionsOffset = alignOffset(sizeof(SnakeEnvHeader));
+    const quint32 observationsOffset = alignOffset(actionsOffset + count);
+    const quint32 rewardsOffset = alignOffset(observationsOffset + count * observationBytes);
+    const quint32 donesOffset = alignOffset(rewardsOffset + count * sizeof(float));
+    const quint32 totalBytes = alignOffset(donesOffset + count);
+
+    char *memory = nullptr;
+    if (m_config.sharedMemoryKey.isEmpty()) {
+        m_localMemory.assign(totalBytes / sizeof(quint64), 0);
+        memory = reinterpret_cast<char *>(m_localMemory.data());
+    } else {
+        // Ключ не хешируется Qt, чтобы процесс без Qt мог найти сегмент
+        m_sharedMemory.setNativeKey(m_config.sharedMemoryKey);
+        m_nativeKeyUtf8 = m_config.sharedMemoryKey.toUtf8();
+        if (!m_sharedMemory.create(int(totalBytes))) {
+            if (m_sharedMemory.error() != QSharedMemory::AlreadyExists || !m_sharedMemory.attach()) {
+                m_errorString = m_sharedMemory.errorString();
+                return;
+            }
+            if (m_sharedMemory.size() < int(totalBytes)) {
+                m_errorString = QStringLiteral("shared memory segment is too small");
+                m_sharedMemory.detach();
+                return;
+            }
+        }
+        memory = static_cast<char *>(m_sharedMemory.data());
+        std::memset(memory, 0, totalBytes);
+    }
+
+    m_header = new (memory) SnakeEnvHeader;
+    m_header->magic = SnakeEnvHeader::MAGIC;
+    m_header->version = SnakeEnvHeader::VERSION;
+    m_header->numEnvs = count;
+    m_header->observationType = quint32(m_config.observation);
+    m_header->observationBytes = observationBytes;
+    m_header->actionsOffset = actionsOffset;
+    m_header->observationsOffset = observationsOffset;
+    m_header->rewardsOffset = rewardsOffset;
+    m_header->donesOffset = donesOffset;
+    m_header->stopRequested.storeRelease(0);
+    m_header->stepCount.storeRelease(0);
+    m_header->actionCount.storeRelease(0);
+
+    m_actions = reinterpret_cast<quint8 *>(memory + actionsOffset);
+    m_observations = memory + observationsOffset;
+    m_rewards = reinterpret_cast<float *>(memory + rewardsOffset);
+    m_dones = reinterpret_cast<quint8 *>(memory + donesOffset);
+
+    m_states.resize(count);
+    m_bodyX.resize(size_t(count) * m_config.maxLength);
+    m_bodyY.resize(size_t(count) * m_config.maxLength);
+
+    // Несколько блоков на поток, чтобы выровнять нагрузку, но не мельче MIN_ENVS_PER_CHUNK
+    const int maxChunks = qMax(1, QThread::idealThreadCount() * 4);
+    const int chunks = qBound(1, m_config.numEnvs / MIN_ENVS_PER_CHUNK, maxChunks);
+    for (int i = 0; i < chunks; i++) {
+        m_ranges.append({m_config.numEnvs * i / chunks, m_config.numEnvs * (i + 1) / chunks});
+    }
+
+    reset();
+}
+
+SnakeEnvBatch::~SnakeEnvBatch()
+{
+    if (m_header) {
+        m_header->~SnakeEnvHeader();
+    }
+}
+
+float &SnakeEnvBatch::bodyX(int index, int segment)
+{
+    const EnvState &state = m_states[index];
+    return m_bodyX[size_t(index) * m_config.maxLength + (state.head + segment) % m_config.maxLength];
+}
+
+float &SnakeEnvBatch::bodyY(int index, int segment)
+{
+    const EnvState &state = m_states[index];
+    return m_bodyY[size_t(index) * m_config.maxLength + (state.head + segment) % m_config.maxLength];
+}
+
+/**
+ * @brief Равномерное случайное число в [lowest, highest) (splitmix64)
+ */
+float SnakeEnvBatch::nextRandom(EnvState &state, float lowest, float highest)
+{
+    quint64 z = (state.random += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    return lowest + (highest - lowest) * float(z >> 40) / float(1 << 24);
+}
+
+void SnakeEnvBatch::reset()
+{
+    for (int i = 0; i < m_config.numEnvs; i++) {
+        m_states[i].random = m_config.seed + quint64(i) * 0x632be59bd9b4e019ULL;
+        resetEnv(i);
+        writeObservation(i);
+        m_rewards[i] = 0;
+        m_dones[i] = Running;
+        m_actions[i] = 0;
+    }
+}
+
+/**
+ * @brief Начальное состояние игры (как SnakeGame::initGame)
+ */
+void SnakeEnvBatch::resetEnv(int index)
+{
+    EnvState &state = m_states[index];
+    state.angle = 0;
+    state.speed = 0;
+    state.progress = 0;
+    state.score = 0;
+    state.head = 0;
+    state.length = INITIAL_LENGTH;
+    state.steps = 0;
+
+    const float start = m_config.fieldSize / 2.0f;
+    for (int i = 0; i < INITIAL_LENGTH; i++) {
+        bodyX(index, i) = start - i * SEGMENT_DISTANCE;
+        bodyY(index, i) = start;
+    }
+
+    placeApple(index);
+}
+
+/**
+ * @brief Размещает яблоко не ближе APPLE_CLEARANCE к телу (как SnakeGame::locateApple)
+ *
+ * Число попыток ограничено, чтобы длинная змейка не останавливала шаг.
+ */
+void SnakeEnvBatch::placeApple(int index)
+{
+    EnvState &state = m_states[index];
+    const float limit = m_config.fieldSize - DOT_SIZE;
+
+    for (int attempt = 0; attempt < APPLE_ATTEMPTS; attempt++) {
+        state.appleX = std::floor(nextRandom(state, DOT_SIZE, limit));
+        state.appleY = std::floor(nextRandom(state, DOT_SIZE, limit));
+
+        bool onSnake = false;
+        for (int i = 0; i < state.length && !onSnake; i++) {
+            const float dx = bodyX(index, i) - state.appleX;
+            const float dy = bodyY(index, i) - state.appleY;
+            onSnake = dx * dx + dy * dy < APPLE_CLEARANCE * APPLE_CLEARANCE;
+        }
+        if (!onSnake) return;
+    }
+}
+
+void SnakeEnvBatch::step()
+{
+    auto stepRange = [this](const Range &range) {
+        for (int i = range.begin; i < range.end; i++) {
+            stepEnv(i);
+        }
+    };
+
+    if (m_ranges.size() == 1) {
+        stepRange(m_ranges.first());
+    } else {
+        QtConcurrent::blockingMap(m_ranges, stepRange);
+    }
+
+    m_header->stepCount.fetchAndAddRelease(1);
+}
+
+qint64 SnakeEnvBatch::serve(int idleTimeoutMs)
+{
+    QElapsedTimer idle;
+    idle.start();
+    qint64 steps = 0;
+    int spins = 0;
+
+    while (!m_header->stopRequested.loadAcquire()) {
+        if (m_header->actionCount.loadAcquire() > m_header->stepCount.loadAcquire()) {
+            step();
+            steps++;
+            spins = 0;
+            idle.restart();
+            continue;
+        }
+
+        if (idleTimeoutMs >= 0 && idle.hasExpired(idleTimeoutMs)) break;
+
+        if (++spins < SERVE_SPIN_LIMIT) {
+            QThread::yieldCurrentThread();
+        } else {
+            QThread::usleep(SERVE_SLEEP_US);
+        }
+    }
+
+    return steps;
+}
+
+/**
+ * @brief Шаг одной игры: управление, движение, столкновения, автоперезапуск
+ */
+void SnakeEnvBatch::stepEnv(int index)
+{
+    EnvState &state = m_states[index];
+    const quint8 action = m_actions[index];
+    const int capacity = m_config.maxLength;
+
+    // Управление (SnakeGame::turnLeft/turnRight/accelerate/decelerate)
+    if (action & TurnLeft) {
+        state.angle -= TURN_SPEED;
+        if (state.angle < 0) state.angle += TWO_PI;
+    }
+    if (action & TurnRight) {
+        state.angle += TURN_SPEED;
+        if (state.angle >= TWO_PI) state.angle -= TWO_PI;
+    }
+    if (action & Accelerate) state.speed = qMin(state.speed + ACCELERATION, MAX_SPEED);
+    if (action & Decelerate) state.speed = qMax(state.speed - ACCELERATION * 2, 0.0f);
+
+    // Движение (SnakeGame::move)
+    const float previousX = bodyX(index, 0);
+    const float previousY = bodyY(index, 0);
+    state.progress += state.speed;
+    if (state.progress >= SEGMENT_DISTANCE) {
+        state.progress = 0;
+
+        const float headX = teleport(bodyX(index, 0) + SEGMENT_DISTANCE * std::cos(state.angle),
+                                     m_config.fieldSize);
+        const float headY = teleport(bodyY(index, 0) + SEGMENT_DISTANCE * std::sin(state.angle),
+                                     m_config.fieldSize);
+
+        if (state.length == capacity) state.length--;
+        state.head = (state.head + capacity - 1) % capacity;
+        state.length++;
+        bodyX(index, 0) = headX;
+        bodyY(index, 0) = headY;
+
+        if (state.length > INITIAL_LENGTH + state.score / 10) state.length--;
+    }
+
+    // Столкновения (SnakeGame::checkCollision): проверяется весь путь головы за шаг
+    const float headX = bodyX(index, 0);
+    const float headY = bodyY(index, 0);
+    float fromX = previousX;
+    float fromY = previousY;
+    float reward = 0;
+    Done done = Running;
+
+    // После телепортации путь головы не непрерывен - проверяется только конечная точка
+    if (std::fabs(headX - fromX) + std::fabs(headY - fromY) > SEGMENT_DISTANCE * 2) {
+        fromX = headX;
+        fromY = headY;
+    }
+
+    for (int i = 4; i < state.length; i++) {
+        if (distanceToSegmentSquared(bodyX(index, i), bodyY(index, i), fromX, fromY, headX, headY)
+            < SELF_HIT_DISTANCE * SELF_HIT_DISTANCE) {
+            reward = -1;
+            done = Terminated;
+            break;
+        }
+    }
+
+    if (done == Running) {
+        if (distanceToSegmentSquared(state.appleX, state.appleY, fromX, fromY, headX, headY)
+            < APPLE_HIT_DISTANCE * APPLE_HIT_DISTANCE) {
+            state.score += 10;
+            reward = 1;
+            placeApple(index);
+
+            if (state.length < INITIAL_LENGTH + state.score / 10 + GROWTH_BUFFER
+                && state.length < capacity) {
+                bodyX(index, state.length) = bodyX(index, state.length - 1);
+                bodyY(index, state.length) = bodyY(index, state.length - 1);
+                state.length++;
+            }
+        }
+    }
+
+    // Ограничение длины отличается от гибели, чтобы обучение продолжало оценку ценности
+    if (++state.steps >= m_config.maxSteps && done == Running) {
+        done = Truncated;
+    }
+
+    m_rewards[index] = reward;
+    m_dones[index] = done;
+
+    if (done != Running) {
+        resetEnv(index);
+    }
+    writeObservation(index);
+}
+
+void SnakeEnvBatch::writeObservation(int index)
+{
+    const EnvState &state = m_states[index];
+    const float field = float(m_config.fieldSize);
+
+    if (m_config.observation == Observation::Grid) {
+        const int grid = m_config.gridSize;
+        quint8 *cells = static_cast<quint8 *>(m_observations) + size_t(index) * grid * grid;
+        std::memset(cells, 0, size_t(grid) * grid);
+
+        auto mark = [&](float x, float y, quint8 value) {
+            const int cx = int(x * grid / field);
+            const int cy = int(y * grid / field);
+            if (x >= 0 && y >= 0 && cx < grid && cy < grid) {
+                cells[cy * grid + cx] = value;
+            }
+        };
+
+        for (int i = state.length - 1; i >= 0; i--) {
+            mark(bodyX(index, i), bodyY(index, i), i == 0 ? 2 : 1);
+        }
+        mark(state.appleX, state.appleY, 3);
+        return;
+    }
+
+    // Признаки в системе координат головы: вперед - по направлению движения
+    const float headX = bodyX(index, 0);
+    const float headY = bodyY(index, 0);
+    const float cosA = std::cos(state.angle);
+    const float sinA = std::sin(state.angle);
+
+    auto forward = [&](float x, float y) { return ((x - headX) * cosA + (y - headY) * sinA) / field; };
+    auto side = [&](float x, float y) { return ((y - headY) * cosA - (x - headX) * sinA) / field; };
+
+    // Ближайший сегмент, с которым возможно столкновение
+    float nearestForward = 1;
+    float nearestSide = 0;
+    float nearestDistance = -1;
+    for (int i = 4; i < state.length; i++) {
+        const float dx = bodyX(index, i) - headX;
+        const float dy = bodyY(index, i) - headY;
+        const float distance = dx * dx + dy * dy;
+        if (nearestDistance < 0 || distance < nearestDistance) {
+            nearestDistance = distance;
+            nearestForward = forward(bodyX(index, i), bodyY(index, i));
+            nearestSide = side(bodyX(index, i), bodyY(index, i));
+        }
+    }
+
+    float *features = static_cast<float *>(m_observations) + size_t(index) * FEATURE_COUNT;
+    features[0] = headX / field * 2 - 1;
+    features[1] = headY / field * 2 - 1;
+    features[2] = cosA;
+    features[3] = sinA;
+    features[4] = state.speed / MAX_SPEED;
+    features[5] = forward(state.appleX, state.appleY);
+    features[6] = side(state.appleX, state.appleY);
+    features[7] = float(state.length) / m_config.maxLength;
+    features[8] = nearestForward;
+    features[9] = nearestSide;
+}
+
+SnakeEnvBatch *snake_env_create(int numEnvs, int observation, int gridSize,
+                                unsigned long long seed, const char *sharedMemoryKey)
+{
+    SnakeEnvBatch::Config config;
+    config.numEnvs = numEnvs;
+    config.observation = observation == 0 ? SnakeEnvBatch::Observation::Grid
+                                          : SnakeEnvBatch::Observation::Features;
+    config.gridSize = gridSize;
+    config.seed = seed;
+    if (sharedMemoryKey) {
+        config.sharedMemoryKey = QString::fromUtf8(sharedMemoryKey);
+    }
+
+    SnakeEnvBatch *env = new SnakeEnvBatch(config);
+    if (!env->isValid()) {
+        delete env;
+        return nullptr;
+    }
+    return env;
+}
+
+void snake_env_destroy(SnakeEnvBatch *env)
+{
+    delete env;
+}
+
+void snake_env_reset(SnakeEnvBatch *env)
+{
+    env->reset();
+}
+
+void snake_env_step(SnakeEnvBatch *env)
+{
+    env->step();
+}
+
+long long snake_env_serve(SnakeEnvBatch *env, int idleTimeoutMs)
+{
+    return env->serve(idleTimeoutMs);
+}
+
+unsigned char *snake_env_actions(SnakeEnvBatch *env)
+{
+    return env->actions();
+}
+
+const void *snake_env_observations(SnakeEnvBatch *env)
+{
+    return env->observations();
+}
+
+const float *snake_env_rewards(SnakeEnvBatch *env)
+{
+    return env->rewards();
+}
+
+const unsigned char *snake_env_dones(SnakeEnvBatch *env)
+{
+    return env->dones();
+}
+
+int snake_env_observation_bytes(SnakeEnvBatch *env)
+{
+    return env->observationBytes();
+}
+
+const char *snake_env_native_key(SnakeEnvBatch *env)
+{
+    return env->nativeKeyUtf8();
+}
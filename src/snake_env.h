@@ -0,0 +1,217 @@
+#pragma once
+
+#include <QtGlobal>
+#include <QAtomicInteger>
+#include <QByteArray>
+#include <QSharedMemory>
+#include <QString>
+#include <QVector>
+#include <cstddef>
+#include <vector>
+
+#if defined(SNAKE_ENV_LIBRARY)
+#  define SNAKE_ENV_EXPORT Q_DECL_EXPORT
+#else
+#  define SNAKE_ENV_EXPORT Q_DECL_IMPORT
+#endif
+
+/**
+ * @struct SnakeEnvHeader
+ * @brief Заголовок общего буфера окружения
+ *
+ * Лежит в начале буфера (в том числе в разделяемой памяти), чтобы процесс
+ * обучения мог найти массивы действий, наблюдений, наград и флагов
+ * завершения без знания внутренностей SnakeEnvBatch.
+ *
+ * Обмен через разделяемую память (окружение крутит SnakeEnvBatch::serve()):
+ *   1. обучение записывает действия и сохраняет actionCount = stepCount + 1;
+ *   2. окружение выполняет шаг и увеличивает stepCount;
+ *   3. обучение ждет stepCount == actionCount и читает результаты.
+ * Счетчики только растут; actionCount и stopRequested пишет только процесс
+ * обучения, stepCount - только окружение. Выровненные 64-битные записи
+ * атомарны на поддерживаемых платформах, поэтому обучению достаточно
+ * обычной записи с барьером (release) после заполнения действий.
+ *
+ * Процесс без Qt находит сегмент по платформенному ключу (Config::sharedMemoryKey
+ * передается в QSharedMemory::setNativeKey() без изменений):
+ *   Windows - имя отображения файла (OpenFileMappingW);
+ *   Unix (System V) - shmget(ftok(ключ, 'Q')), где ключ - путь к файлу,
+ *   который окружение создает при создании сегмента.
+ * Смещения полей заголовка фиксированы и проверяются static_assert ниже.
+ */
+struct SnakeEnvHeader
+{
+    static const quint32 MAGIC = 0x564e4553;     ///< "SENV"
+    static const quint32 VERSION = 3;
+
+    quint32 magic;                               ///< Смещение 0
+    quint32 version;                             ///< Смещение 4
+    quint32 numEnvs;                             ///< 8: количество игр K
+    quint32 observationType;                     ///< 12: SnakeEnvBatch::Observation
+    quint32 observationBytes;                    ///< 16: размер наблюдения одной игры в байтах
+    quint32 actionsOffset;                       ///< 20: quint8[K], битовая маска SnakeEnvBatch::Action
+    quint32 observationsOffset;                  ///< 24: quint8[K][G*G] или float[K][FEATURE_COUNT]
+    quint32 rewardsOffset;                       ///< 28: float[K]
+    quint32 donesOffset;                         ///< 32: quint8[K], SnakeEnvBatch::Done
+    QAtomicInteger<quint32> stopRequested;       ///< 36: ненулевое значение завершает serve()
+    QAtomicInteger<quint64> stepCount;           ///< 40: увеличивается после заполнения буферов шагом
+    QAtomicInteger<quint64> actionCount;         ///< 48: увеличивается обучением после записи действий
+};
+
+// Раскладка заголовка - часть протокола с процессом обучения
+static_assert(offsetof(SnakeEnvHeader, donesOffset) == 32, "SnakeEnvHeader layout changed");
+static_assert(offsetof(SnakeEnvHeader, stopRequested) == 36, "SnakeEnvHeader layout changed");
+static_assert(offsetof(SnakeEnvHeader, stepCount) == 40, "SnakeEnvHeader layout changed");
+static_assert(offsetof(SnakeEnvHeader, actionCount) == 48, "SnakeEnvHeader layout changed");
+static_assert(sizeof(SnakeEnvHeader) == 56, "SnakeEnvHeader layout changed");
+
+/**
+ * @class SnakeEnvBatch
+ * @brief Пакетное окружение "Змейки" для обучения с подкреплением
+ *
+ * Шагает K игр одновременно по массиву действий и записывает наблюдения,
+ * награды и флаги завершения в заранее выделенные непрерывные массивы.
+ * Правила совпадают с SnakeGame::move() и SnakeGame::checkCollision()
+ * (включая проверку всего пути головы за шаг), но без виджета, таймера,
+ * визуальной интерполяции и режима фиксированной точки. Завершившиеся игры
+ * перезапускаются сразу, и их наблюдение относится уже к новой игре.
+ * Игры делятся на блоки, которые обрабатываются в пуле потоков QtConcurrent.
+ */
+class SNAKE_ENV_EXPORT SnakeEnvBatch
+{
+public:
+    /// Вид наблюдения
+    enum class Observation : quint32 {
+        Grid = 0,       ///< Сетка занятости G*G байт: 0 пусто, 1 тело, 2 голова, 3 яблоко
+        Features = 1    ///< FEATURE_COUNT признаков float относительно головы
+    };
+
+    /// Биты действия, соответствуют клавишам управления игры
+    enum Action : quint8 {
+        TurnLeft = 1,
+        TurnRight = 2,
+        Accelerate = 4,
+        Decelerate = 8
+    };
+
+    /// Значения флага завершения в dones()
+    enum Done : quint8 {
+        Running = 0,        ///< Игра продолжается
+        Terminated = 1,     ///< Столкновение: терминальное состояние
+        Truncated = 2       ///< Достигнут maxSteps: эпизод прерван, состояние не терминальное
+    };
+
+    struct Config {
+        int numEnvs = 64;                            ///< Количество игр K
+        Observation observation = Observation::Features;
+        int gridSize = 32;                           ///< Сторона сетки G для Observation::Grid
+        int fieldSize = 600;                         ///< Размер игрового поля
+        int maxLength = 1024;                        ///< Максимальная длина змейки
+        int maxSteps = 10000;                        ///< Ограничение длины эпизода
+        quint64 seed = 1;                            ///< Зерно генераторов игр
+        QString sharedMemoryKey;                     ///< Платформенный ключ разделяемой памяти (пусто - память процесса)
+    };
+
+    static const int FEATURE_COUNT = 10;
+
+    explicit SnakeEnvBatch(const Config &config);
+    ~SnakeEnvBatch();
+
+    bool isValid() const { return m_header != nullptr; }
+    QString errorString() const { return m_errorString; }
+    QString nativeKey() const { return m_sharedMemory.nativeKey(); }  ///< Пусто, если память процесса
+    const char *nativeKeyUtf8() const { return m_nativeKeyUtf8.constData(); }
+
+    void reset();   ///< Перезапускает все игры и записывает наблюдения
+    void step();    ///< Выполняет один шаг всех игр по массиву actions()
+
+    /**
+     * @brief Выполняет шаги по запросам другого процесса (см. SnakeEnvHeader)
+     * @param idleTimeoutMs Выход, если столько миллисекунд нет запросов (-1 - без ограничения)
+     * @return Количество выполненных шагов
+     *
+     * Завершается также при ненулевом stopRequested.
+     */
+    qint64 serve(int idleTimeoutMs = -1);
+
+    int numEnvs() const { return m_config.numEnvs; }
+    int observationBytes() const { return int(m_header->observationBytes); }
+
+    quint8 *actions() { return m_actions; }
+    const void *observations() const { return m_observations; }
+    const float *rewards() const { return m_rewards; }
+    const quint8 *dones() const { return m_dones; }
+
+private:
+    /// Состояние одной игры; тело хранится в кольцевом буфере длины maxLength
+    struct EnvState {
+        float angle;
+        float speed;
+        float progress;
+        float appleX;
+        float appleY;
+        int score;
+        int head;
+        int length;
+        int steps;
+        quint64 random;
+    };
+
+    /// Диапазон игр, обрабатываемый одной задачей пула потоков
+    struct Range {
+        int begin;
+        int end;
+    };
+
+    void resetEnv(int index);
+    void stepEnv(int index);
+    void placeApple(int index);
+    void writeObservation(int index);
+    float nextRandom(EnvState &state, float lowest, float highest);
+
+    float &bodyX(int index, int segment);
+    float &bodyY(int index, int segment);
+
+    Config m_config;
+    QString m_errorString;
+
+    QSharedMemory m_sharedMemory;
+    QByteArray m_nativeKeyUtf8;                      ///< Ключ для C-интерфейса
+    std::vector<quint64> m_localMemory;              ///< Буфер, если разделяемая память не используется
+
+    SnakeEnvHeader *m_header;
+    quint8 *m_actions;
+    void *m_observations;
+    float *m_rewards;
+    quint8 *m_dones;
+
+    std::vector<EnvState> m_states;
+    std::vector<float> m_bodyX;                      ///< K * maxLength координат X сегментов
+    std::vector<float> m_bodyY;                      ///< K * maxLength координат Y сегментов
+    QVector<Range> m_ranges;
+};
+
+// C-интерфейс для процесса обучения (ctypes, cffi и т.п.)
+extern "C" {
+
+/**
+ * @brief Создает пакетное окружение
+ * @param observation 0 - сетка занятости, 1 - признаки
+ * @param sharedMemoryKey Платформенный ключ разделяемой памяти (см. SnakeEnvHeader) или NULL
+ * @return Указатель на окружение или NULL при ошибке
+ */
+SNAKE_ENV_EXPORT SnakeEnvBatch *snake_env_create(int numEnvs, int observation, int gridSize,
+                                                 unsigned long long seed, const char *sharedMemoryKey);
+SNAKE_ENV_EXPORT void snake_env_destroy(SnakeEnvBatch *env);
+SNAKE_ENV_EXPORT void snake_env_reset(SnakeEnvBatch *env);
+SNAKE_ENV_EXPORT void snake_env_step(SnakeEnvBatch *env);
+SNAKE_ENV_EXPORT long long snake_env_serve(SnakeEnvBatch *env, int idleTimeoutMs);
+SNAKE_ENV_EXPORT unsigned char *snake_env_actions(SnakeEnvBatch *env);
+SNAKE_ENV_EXPORT const void *snake_env_observations(SnakeEnvBatch *env);
+SNAKE_ENV_EXPORT const float *snake_env_rewards(SnakeEnvBatch *env);
+SNAKE_ENV_EXPORT const unsigned char *snake_env_dones(SnakeEnvBatch *env);
+SNAKE_ENV_EXPORT int snake_env_observation_bytes(SnakeEnvBatch *env);
+/// Платформенный ключ разделяемой памяти в UTF-8 ("" для памяти процесса)
+SNAKE_ENV_EXPORT const char *snake_env_native_key(SnakeEnvBatch *env);
+
+}
@@ -1,15 +1,65 @@
 #include "snake_game.h"
+#include "sprite_blitter.h"
+#include "asset_loader.h"
 #include <QPainter>
 #include <QRandomGenerator>
 #include <QFont>
 #include <QFontMetrics>
 #include <QApplication>
 #include <QDebug>
+#include <cmath>
+#include <algorithm>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
 #endif
 
+namespace {
+
+/**
+ * @brief Расстояние от точки до отрезка [from, to]
+ * 
+ * Используется для проверки столкновения с круглым объектом
+ * по всему пути головы за такт (капсула), а не только в конечной точке.
+ */
+qreal distanceToSegment(const QPointF &point, const QPointF &from, const QPointF &to)
+{
+    const QPointF segment = to - from;
+    const qreal lengthSquared = QPointF::dotProduct(segment, segment);
+    
+    qreal t = 0;
+    if (lengthSquared > 0) {
+        t = qBound(0.0, QPointF::dotProduct(point - from, segment) / lengthSquared, 1.0);
+    }
+    
+    const QPointF nearest = from + segment * t;
+    return std::hypot(point.x() - nearest.x(), point.y() - nearest.y());
+}
+
+/**
+ * @brief Угол вращения яблока в градусах, [0, 360)
+ * 
+ * Время берется по модулю полного оборота (7200 мс при 20 мс на градус),
+ * иначе угол от начала эпохи не помещается в int при переводе в кадр.
+ */
+qreal appleRotation()
+{
+    return (QDateTime::currentMSecsSinceEpoch() % 7200) / 20.0;
+}
+
+/**
+ * @brief Индекс заранее повернутого кадра для угла в градусах
+ * @param steps Число кадров на полный оборот
+ */
+int rotationFrameIndex(qreal degrees, int steps)
+{
+    const qreal turns = std::fmod(degrees, 360.0);
+    const int index = qRound(turns * steps / 360.0) % steps;
+    return index < 0 ? index + steps : index;
+}
+
+} // namespace
+
 // Инициализация статических констант
 constexpr qreal SnakeGame::MAX_SPEED;
 constexpr qreal SnakeGame::ACCELERATION;
@@ -26,19 +76,39 @@ SnakeGame::SnakeGame(QWidget *parent) : QWidget(parent),
     m_score(0),
     m_inGame(false),
     m_isPaused(false),
+    m_headless(false),
+    m_autopilotIdleTicks(0),
+    m_headlessRestarts(0),
+    m_random(QRandomGenerator::securelySeeded()),
     m_directionAngle(0),
     m_currentHeadAngle(0),
     m_targetHeadAngle(0),
     m_currentSpeed(0),
     m_movementProgress(0),
     m_interpolationFactor(0),
+    m_fixedPoint(false),
+    m_fixedAngle(0),
+    m_fixedSpeed(0),
+    m_fixedProgress(0),
     m_turningLeft(false),
     m_turningRight(false),
     m_accelerating(false),
-    m_decelerating(false)
+    m_decelerating(false),
+    m_lastTickTime(0),
+    m_latencyIndex(0),
+    m_latencyAverage(0),
+    m_latencyP95(0),
+    m_headSerial(0),
+    m_renderBackend(RenderBackend::Painter),
+    m_bodyStyle(BodyStyle::Sprites)
 {
     setFixedSize(600, 600);
-    setStyleSheet("background-color: white; color: black;");
+    m_inputClock.start();
+    m_latencySamples.reserve(LATENCY_SAMPLES);
+    m_latencySorted.reserve(LATENCY_SAMPLES);
+    
+    connect(&m_appleLoader, &QFutureWatcher<QImage>::finished,
+            this, &SnakeGame::onAppleImageLoaded);
     loadImages();
     setFocusPolicy(Qt::StrongFocus);
 }
@@ -56,8 +126,9 @@ SnakeGame::~SnakeGame()
 /**
  * @brief Загружает изображения для элементов игры (ТРЕБОВАНИЕ 2)
  * 
- * Создает или загружает изображения для сегментов змейки, головы и яблока.
- * Если файл яблока не найден, создается запасной вариант.
+ * Создает изображения для сегментов змейки и головы. Яблоко сначала
+ * рисуется запасным вариантом, а изображение из ресурсов декодируется
+ * в фоновом потоке и подставляется в onAppleImageLoaded().
  */
 void SnakeGame::loadImages()
 {
@@ -86,25 +157,107 @@ void SnakeGame::loadImages()
     headPainter.drawEllipse(2, 2, 3, 3);
     headPainter.drawEllipse(5, 2, 3, 3);
 
-    // Загрузка изображения яблока с обработкой ошибок
-    QString applePath = QApplication::applicationDirPath() + "/src/pic/apple.jpg";
-    m_appleImage = QImage(applePath);
+    // Создание запасного изображения яблока до окончания загрузки
+    m_appleImage = QImage(DOT_SIZE, DOT_SIZE, QImage::Format_ARGB32);
+    m_appleImage.fill(Qt::transparent);
     
-    if (m_appleImage.isNull()) {
-        // Создание запасного изображения яблока
-        m_appleImage = QImage(DOT_SIZE, DOT_SIZE, QImage::Format_ARGB32);
-        m_appleImage.fill(Qt::transparent);
-        
-        QPainter applePainter(&m_appleImage);
-        applePainter.setRenderHint(QPainter::Antialiasing);
-        applePainter.setBrush(Qt::red);
-        applePainter.setPen(Qt::NoPen);
-        applePainter.drawEllipse(0, 0, DOT_SIZE, DOT_SIZE);
+    QPainter applePainter(&m_appleImage);
+    applePainter.setRenderHint(QPainter::Antialiasing);
+    applePainter.setBrush(Qt::red);
+    applePainter.setPen(Qt::NoPen);
+    applePainter.drawEllipse(0, 0, DOT_SIZE, DOT_SIZE);
+    
+    // Декодирование и масштабирование изображения яблока в фоне (с кэшем на диске)
+    m_appleLoader.setFuture(AssetLoader::loadScaledAsync(":/pic/apple.jpg", 
+                                                         QSize(DOT_SIZE, DOT_SIZE)));
+}
+
+/**
+ * @brief Подставляет изображение яблока после фоновой загрузки
+ * 
+ * При ошибке загрузки остается запасное изображение.
+ */
+void SnakeGame::onAppleImageLoaded()
+{
+    const QImage image = m_appleLoader.result();
+    if (image.isNull()) return;
+    
+    m_appleImage = image;
+    
+    if (m_renderBackend == RenderBackend::Software) {
+        prepareSoftwareSprites();
+    }
+    update();
+}
+
+/**
+ * @brief Выбирает бэкенд отрисовки игрового поля
+ * @param backend Painter - QPainter на каждый спрайт, Software - программный блиттер
+ */
+void SnakeGame::setRenderBackend(RenderBackend backend)
+{
+    m_renderBackend = backend;
+
+    if (m_renderBackend == RenderBackend::Software) {
+        prepareSoftwareSprites();
     } else {
-        // Масштабирование загруженного изображения
-        m_appleImage = m_appleImage.scaled(DOT_SIZE, DOT_SIZE, 
-                                         Qt::KeepAspectRatio, 
-                                         Qt::SmoothTransformation);
+        m_frameBuffer = QImage();
+        m_headFrames.clear();
+        m_appleFrames.clear();
+    }
+}
+
+/**
+ * @brief Готовит спрайты для программного бэкенда
+ *
+ * Блиттер умеет только переносить спрайт со смешиванием, поэтому повороты
+ * и масштабирование выполняются здесь один раз: голова и яблоко рендерятся
+ * в ROTATION_STEPS кадров, тело - в двух масштабах.
+ */
+void SnakeGame::prepareSoftwareSprites()
+{
+    m_frameBuffer = QImage(size(), QImage::Format_ARGB32_Premultiplied);
+
+    // Отрисовка изображения в центре холста с поворотом и масштабом
+    auto renderFrame = [](const QImage &image, qreal angle, qreal scale) {
+        QImage frame(SPRITE_CANVAS, SPRITE_CANVAS, QImage::Format_ARGB32_Premultiplied);
+        frame.fill(Qt::transparent);
+
+        QPainter painter(&frame);
+        painter.setRenderHint(QPainter::Antialiasing);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform);
+        painter.translate(SPRITE_CANVAS / 2, SPRITE_CANVAS / 2);
+        painter.rotate(angle);
+        painter.scale(scale, scale);
+        painter.translate(-DOT_SIZE / 2, -DOT_SIZE / 2);
+        painter.drawImage(0, 0, image);
+        return frame;
+    };
+
+    m_headFrames.resize(ROTATION_STEPS);
+    m_appleFrames.resize(ROTATION_STEPS);
+    for (int i = 0; i < ROTATION_STEPS; i++) {
+        const qreal angle = 360.0 * i / ROTATION_STEPS;
+        m_headFrames[i] = renderFrame(m_headImage, angle, 1.0);
+        m_appleFrames[i] = renderFrame(m_appleImage, angle, 1.1);
+    }
+
+    m_bodyFrames[0] = renderFrame(m_dotImage, 0, 0.9);
+    m_bodyFrames[1] = renderFrame(m_dotImage, 0, 1.0);
+}
+
+/**
+ * @brief Выбирает способ отрисовки тела змейки
+ * @param style Sprites - спрайт на сегмент, SmoothPath - единый сглаженный контур
+ */
+void SnakeGame::setBodyStyle(BodyStyle style)
+{
+    m_bodyStyle = style;
+
+    if (m_bodyStyle == BodyStyle::SmoothPath) {
+        rebuildBodyPath();
+    } else {
+        m_bodyPath = QPainterPath();
     }
 }
 
@@ -118,6 +271,7 @@ void SnakeGame::initGame()
 {
     // Сброс игрового состояния
     m_score = 0;
+    m_autopilotIdleTicks = 0;
     m_snake.clear();
     m_visualSnake.clear();
     m_targetPositions.clear();
@@ -128,33 +282,209 @@ void SnakeGame::initGame()
     m_currentSpeed = 0;
     m_movementProgress = 0;
     m_interpolationFactor = 0;
+    m_fixedAngle = 0;
+    m_fixedSpeed = 0;
+    m_fixedProgress = 0;
     
     m_turningLeft = false;
     m_turningRight = false;
     m_accelerating = false;
     m_decelerating = false;
+    m_inputQueue.clear();
+    m_lastTickTime = m_inputClock.nsecsElapsed();
     
     // Создание начальной змейки из 3 сегментов
     const qreal startX = 300;
     const qreal startY = 300;
     
+    // Сетка покрывает поле вместе с зоной телепортации
+    m_bodyGrid.reset(QRectF(rect()).adjusted(-DOT_SIZE * 3, -DOT_SIZE * 3, DOT_SIZE * 3, DOT_SIZE * 3),
+                     DOT_SIZE * 2);
+    m_headSerial = 0;
+    
     for (int i = 0; i < 3; i++) {
         QPointF segment(startX - i * SEGMENT_DISTANCE, startY);
-        m_snake.append(segment);
+        appendSegment(segment);
         m_visualSnake.append(segment);
     }
     
+    m_previousHead = m_snake.first();
     m_targetPositions = m_snake;
     locateApple(); // Размещение яблока на поле
     
+    if (m_bodyStyle == BodyStyle::SmoothPath) {
+        rebuildBodyPath();
+    }
+    
     m_inGame = true;
     m_isPaused = false;
     
     emit scoreChanged(m_score);
     
-    // Запуск игрового таймера
-    m_timerId = startTimer(DELAY);
-    setFocus();
+    // Запуск игрового таймера (в безголовом режиме такты вызываются через step())
+    if (!m_headless) {
+        m_timerId = startTimer(DELAY);
+        setFocus();
+    }
+}
+
+/**
+ * @brief Запускает игру без таймера под управлением автопилота
+ * @param seed Зерно генератора позиций яблока
+ * 
+ * При одинаковом зерне последовательность тактов воспроизводится полностью,
+ * поэтому прогон годится и для бенчмарка, и для сбора профиля PGO.
+ */
+void SnakeGame::startHeadless(quint32 seed)
+{
+    if (m_timerId != 0) {
+        killTimer(m_timerId);
+        m_timerId = 0;
+    }
+    
+    m_headless = true;
+    m_headlessRestarts = 0;
+    m_random.seed(seed);
+    initGame();
+}
+
+/**
+ * @brief Выполняет один такт игры в безголовом режиме
+ * 
+ * После столкновения игра перезапускается, чтобы прогон продолжался.
+ */
+void SnakeGame::step()
+{
+    if (!m_inGame) {
+        m_headlessRestarts++;
+        initGame();
+    }
+    
+    autopilot();
+    
+    // Автопилот держит клавиши весь такт
+    const qreal amounts[ControlCount] = {
+        m_turningLeft ? 1.0 : 0.0,
+        m_turningRight ? 1.0 : 0.0,
+        m_accelerating ? 1.0 : 0.0,
+        m_decelerating ? 1.0 : 0.0
+    };
+    applyControls(amounts);
+    
+    move();
+    checkCollision();
+}
+
+/**
+ * @brief Возвращает объем памяти, зарезервированной контейнерами состояния
+ * 
+ * Учитывается емкость, а не размер, чтобы длительный прогон замечал
+ * контейнеры, которые растут и не отдают память. Исключение - контур
+ * m_bodyPath: QPainterPath не сообщает емкость, поэтому берется число
+ * элементов (нижняя оценка).
+ */
+qint64 SnakeGame::stateFootprint() const
+{
+    qint64 bytes = qint64(m_snake.capacity()) * sizeof(QPointF)
+                 + qint64(m_visualSnake.capacity()) * sizeof(QPointF)
+                 + qint64(m_targetPositions.capacity()) * sizeof(QPointF)
+                 + qint64(m_inputQueue.capacity()) * sizeof(InputEvent)
+                 + qint64(m_appliedInputTimes.capacity()) * sizeof(qint64)
+                 + qint64(m_latencySamples.capacity()) * sizeof(qint64)
+                 + qint64(m_latencySorted.capacity()) * sizeof(qint64)
+                 + qint64(m_bodyPath.elementCount()) * sizeof(QPainterPath::Element)
+                 + m_bodyGrid.capacityBytes();
+    
+    // Ресурсы программного бэкенда отрисовки
+    bytes += m_frameBuffer.sizeInBytes();
+    for (const QImage &frame : m_headFrames) {
+        bytes += frame.sizeInBytes();
+    }
+    for (const QImage &frame : m_appleFrames) {
+        bytes += frame.sizeInBytes();
+    }
+    for (const QImage &frame : m_bodyFrames) {
+        bytes += frame.sizeInBytes();
+    }
+    return bytes;
+}
+
+/**
+ * @brief Сводка текущего состояния симуляции
+ * 
+ * Координаты переводятся в Q16.16 и хешируются побайтно в фиксированном
+ * порядке, поэтому в режиме фиксированной точки сводка совпадает
+ * для любых сборок, а отличие указывает на недетерминированность.
+ */
+SnakeGame::StateDigest SnakeGame::stateDigest() const
+{
+    StateDigest digest;
+    digest.score = m_score;
+    digest.length = m_snake.size();
+    digest.headX = m_snake.isEmpty() ? 0 : FixedMath::fromReal(m_snake.first().x());
+    digest.headY = m_snake.isEmpty() ? 0 : FixedMath::fromReal(m_snake.first().y());
+    digest.angle = m_fixedAngle;
+    
+    // FNV-1a (64 бита) по младшим байтам вперед
+    quint64 hash = 0xcbf29ce484222325ULL;
+    auto mix = [&hash](quint32 value) {
+        for (int shift = 0; shift < 32; shift += 8) {
+            hash ^= (value >> shift) & 0xff;
+            hash *= 0x100000001b3ULL;
+        }
+    };
+    for (const QPointF &segment : m_snake) {
+        mix(quint32(FixedMath::fromReal(segment.x())));
+        mix(quint32(FixedMath::fromReal(segment.y())));
+    }
+    digest.bodyHash = hash;
+    
+    return digest;
+}
+
+/**
+ * @brief Поворачивает змейку в сторону яблока и держит среднюю скорость
+ */
+void SnakeGame::autopilot()
+{
+    if (m_snake.isEmpty()) return;
+    
+    m_accelerating = m_currentSpeed < MAX_SPEED / 2;
+    m_decelerating = false;
+    
+    // Яблоко внутри круга разворота (радиус ~50 при скорости автопилота)
+    // недостижимо погоней: змейка кружит вокруг него бесконечно.
+    // Такое яблоко переносится, чтобы прогон доходил до длинной змейки.
+    if (++m_autopilotIdleTicks > AUTOPILOT_STALL_TICKS) {
+        m_autopilotIdleTicks = 0;
+        locateApple();
+    }
+    
+    if (m_fixedPoint) {
+        // Без atan2: знак векторного произведения дает сторону поворота,
+        // а сравнение с tan(TURN_SPEED / 2) * скалярное - мертвую зону
+        const qint64 tanHalfTurn = 2623; // tan(TURN_SPEED / 2) в Q16.16
+        
+        const qint64 dx = FixedMath::fromReal(m_applePos.x()) - FixedMath::fromReal(m_snake.first().x());
+        const qint64 dy = FixedMath::fromReal(m_applePos.y()) - FixedMath::fromReal(m_snake.first().y());
+        const qint64 c = FixedMath::cos(m_fixedAngle);
+        const qint64 s = FixedMath::sin(m_fixedAngle);
+        
+        const qint64 cross = c * dy - s * dx;
+        const qint64 dot = c * dx + s * dy;
+        const qint64 threshold = dot > 0 ? (dot >> FixedMath::FRACTION_BITS) * tanHalfTurn : 0;
+        
+        m_turningRight = cross > threshold || (dot <= 0 && cross >= 0);
+        m_turningLeft = cross < -threshold || (dot <= 0 && cross < 0);
+        return;
+    }
+    
+    const QPointF toApple = m_applePos - m_snake.first();
+    const qreal targetAngle = std::atan2(toApple.y(), toApple.x());
+    const qreal delta = std::remainder(targetAngle - m_directionAngle, 2 * M_PI);
+    
+    m_turningLeft = delta < -TURN_SPEED / 2;
+    m_turningRight = delta > TURN_SPEED / 2;
 }
 
 /**
@@ -171,21 +501,19 @@ void SnakeGame::locateApple()
         onSnake = false;
         
         // Генерация случайной позиции в пределах поля
-        const qreal x = QRandomGenerator::global()->bounded(DOT_SIZE, width() - DOT_SIZE);
-        const qreal y = QRandomGenerator::global()->bounded(DOT_SIZE, height() - DOT_SIZE);
+        const qreal x = m_random.bounded(DOT_SIZE, width() - DOT_SIZE);
+        const qreal y = m_random.bounded(DOT_SIZE, height() - DOT_SIZE);
         m_applePos = QPointF(x, y);
         
-        // Проверка, не попадает ли яблоко на змейку
-        for (const QPointF &segment : m_snake) {
-            const qreal dx = segment.x() - m_applePos.x();
-            const qreal dy = segment.y() - m_applePos.y();
-            const qreal distance = std::hypot(dx, dy);
-            
-            if (distance < DOT_SIZE * 2) {
+        // Проверка, не попадает ли яблоко на змейку (только ближайшие ячейки сетки)
+        const qreal clearance = DOT_SIZE * 2;
+        const QRectF area(m_applePos.x() - clearance, m_applePos.y() - clearance,
+                          clearance * 2, clearance * 2);
+        m_bodyGrid.query(area, [&](int serial) {
+            if (isNearPath(m_snake[m_headSerial - serial], m_applePos, m_applePos, clearance)) {
                 onSnake = true;
-                break;
             }
-        }
+        });
     } while (onSnake);
 }
 
@@ -200,50 +528,68 @@ void SnakeGame::move()
 {
     if (m_snake.isEmpty()) return;
     
-    // Обработка ввода пользователя (управление стрелками/WASD)
-    if (m_turningLeft) turnLeft();
-    if (m_turningRight) turnRight();
-    if (m_accelerating) accelerate();
-    if (m_decelerating) decelerate();
+    m_previousHead = m_snake.first();
     
     // Плавная интерполяция угла поворота головы
     m_targetHeadAngle = m_directionAngle;
     m_currentHeadAngle += (m_targetHeadAngle - m_currentHeadAngle) * 0.2;
     
     // Обновление прогресса движения
-    m_movementProgress += m_currentSpeed;
+    bool nextSegment;
+    if (m_fixedPoint) {
+        m_fixedProgress += m_fixedSpeed;
+        nextSegment = m_fixedProgress >= FixedMath::fromReal(SEGMENT_DISTANCE);
+        m_movementProgress = FixedMath::toReal(m_fixedProgress);
+    } else {
+        m_movementProgress += m_currentSpeed;
+        nextSegment = m_movementProgress >= SEGMENT_DISTANCE;
+    }
     
     // Добавление нового сегмента при достаточном прогрессе
-    if (m_movementProgress >= SEGMENT_DISTANCE) {
+    if (nextSegment) {
         m_movementProgress = 0;
+        m_fixedProgress = 0;
         
         // Сохранение текущих позиций для интерполяции
         m_targetPositions = m_snake;
         
-        // ████████████████████████████████████████████████████████████████████████
-        // ИСПОЛЬЗОВАНИЕ МАТРИЦЫ ПЕРЕМЕЩЕНИЯ ДЛЯ АФФИННЫХ ПРЕОБРАЗОВАНИЙ
-        // ████████████████████████████████████████████████████████████████████████
-        
-        m_movementTransform.reset(); // Сбрасываем матрицу преобразований
-        
-        // 1. Перенос в текущую позицию головы
-        m_movementTransform.translate(m_snake.first().x(), m_snake.first().y());
-        
-        // 2. Поворот на текущий угол направления (аффинное преобразование)
-        m_movementTransform.rotate(m_directionAngle * 180 / M_PI);
-        
-        // 3. Перемещение вперед на расстояние сегмента
-        m_movementTransform.translate(SEGMENT_DISTANCE, 0);
-        
-        // 4. Получение новой позиции головы из матрицы преобразования
-        QPointF newHeadPos = m_movementTransform.map(QPointF(0, 0));
+        QPointF newHeadPos;
+        if (m_fixedPoint) {
+            // Целочисленный шаг по таблице синусов: координаты остаются
+            // точно представимыми в Q16.16 и одинаковыми на любой машине
+            const FixedMath::Fixed step = FixedMath::fromReal(SEGMENT_DISTANCE);
+            const FixedMath::Fixed x = FixedMath::fromReal(m_snake.first().x())
+                                     + FixedMath::mul(step, FixedMath::cos(m_fixedAngle));
+            const FixedMath::Fixed y = FixedMath::fromReal(m_snake.first().y())
+                                     + FixedMath::mul(step, FixedMath::sin(m_fixedAngle));
+            newHeadPos = QPointF(FixedMath::toReal(x), FixedMath::toReal(y));
+        } else {
+            // ████████████████████████████████████████████████████████████████████████
+            // ИСПОЛЬЗОВАНИЕ МАТРИЦЫ ПЕРЕМЕЩЕНИЯ ДЛЯ АФФИННЫХ ПРЕОБРАЗОВАНИЙ
+            // ████████████████████████████████████████████████████████████████████████
+            
+            m_movementTransform.reset(); // Сбрасываем матрицу преобразований
+            
+            // 1. Перенос в текущую позицию головы
+            m_movementTransform.translate(m_snake.first().x(), m_snake.first().y());
+            
+            // 2. Поворот на текущий угол направления (аффинное преобразование)
+            m_movementTransform.rotate(m_directionAngle * 180 / M_PI);
+            
+            // 3. Перемещение вперед на расстояние сегмента
+            m_movementTransform.translate(SEGMENT_DISTANCE, 0);
+            
+            // 4. Получение новой позиции головы из матрицы преобразования
+            newHeadPos = m_movementTransform.map(QPointF(0, 0));
+        }
         
         // Добавление новой головы
         m_snake.prepend(newHeadPos);
+        m_bodyGrid.insert(++m_headSerial, newHeadPos);
         
         // Удаление хвоста (остальные части движутся за головой по цепочке)
         if (m_snake.size() > 3 + m_score / 10) {
-            m_snake.removeLast();
+            removeTailSegment();
         }
         
         m_interpolationFactor = 0;
@@ -269,10 +615,19 @@ void SnakeGame::move()
     }
     
     handleBoundaryTeleportation();
+    
+    // Контур тела строится один раз за такт, а не в каждом paintEvent
+    if (m_bodyStyle == BodyStyle::SmoothPath) {
+        rebuildBodyPath();
+    }
 }
 
 /**
  * @brief Проверяет столкновения змейки со стеной или своим телом (ТРЕБОВАНИЕ 6)
+ * 
+ * Проверяется весь путь головы за такт (от m_previousHead до новой позиции),
+ * поэтому при любой скорости голова не проскакивает яблоко или сегмент.
+ * Кандидаты на столкновение берутся из сетки m_bodyGrid.
  */
 void SnakeGame::checkCollision()
 {
@@ -280,37 +635,90 @@ void SnakeGame::checkCollision()
     
     const QPointF head = m_snake.first();
     
+    // После телепортации путь головы не непрерывен - проверяется только конечная точка
+    QPointF from = m_previousHead;
+    if ((head - from).manhattanLength() > SEGMENT_DISTANCE * 2) {
+        from = head;
+    }
+    
     // Проверка столкновения с собственным телом
-    for (int i = 4; i < m_snake.size(); i++) {
-        const qreal dx = head.x() - m_snake[i].x();
-        const qreal dy = head.y() - m_snake[i].y();
-        const qreal distance = std::hypot(dx, dy);
-        
-        if (distance < DOT_SIZE * 0.8) {
-            m_inGame = false;
+    if (sweptBodyHit(from, head)) {
+        m_inGame = false;
+        if (m_timerId != 0) {
             killTimer(m_timerId);
             m_timerId = 0;
-            emit gameOver();
-            return;
         }
+        emit gameOver();
+        return;
     }
     
     // Проверка съедания яблока
-    const qreal appleDx = head.x() - m_applePos.x();
-    const qreal appleDy = head.y() - m_applePos.y();
-    const qreal appleDistance = std::hypot(appleDx, appleDy);
-    
-    if (appleDistance < DOT_SIZE) {
+    if (isNearPath(m_applePos, from, head, DOT_SIZE)) {
         m_score += 10;
+        m_autopilotIdleTicks = 0;
         locateApple(); // Размещаем новое яблоко
         emit scoreChanged(m_score);
         
         // Добавление буфера для плавного роста змейки
         const int growthBuffer = 3;
         if (m_snake.size() < 3 + m_score / 10 + growthBuffer) {
-            m_snake.append(m_snake.last());
+            appendSegment(m_snake.last());
+        }
+    }
+}
+
+/**
+ * @brief Проверяет, задевает ли путь головы сегмент тела начиная с пятого
+ */
+bool SnakeGame::sweptBodyHit(const QPointF &from, const QPointF &to) const
+{
+    const qreal radius = DOT_SIZE * 0.8;
+    const QRectF area = QRectF(from, to).normalized().adjusted(-radius, -radius, radius, radius);
+    
+    bool hit = false;
+    m_bodyGrid.query(area, [&](int serial) {
+        const int index = m_headSerial - serial;
+        if (!hit && index >= 4 && isNearPath(m_snake[index], from, to, radius)) {
+            hit = true;
         }
+    });
+    return hit;
+}
+
+/**
+ * @brief Проверяет, ближе ли точка к пути [from, to], чем radius
+ * 
+ * В режиме фиксированной точки проверка целочисленная.
+ */
+bool SnakeGame::isNearPath(const QPointF &point, const QPointF &from, const QPointF &to, qreal radius) const
+{
+    if (m_fixedPoint) {
+        return FixedMath::segmentCloserThan(
+            FixedMath::fromReal(point.x()), FixedMath::fromReal(point.y()),
+            FixedMath::fromReal(from.x()), FixedMath::fromReal(from.y()),
+            FixedMath::fromReal(to.x()), FixedMath::fromReal(to.y()),
+            FixedMath::fromReal(radius));
     }
+    
+    return distanceToSegment(point, from, to) < radius;
+}
+
+/**
+ * @brief Добавляет сегмент в конец змейки и в сетку
+ */
+void SnakeGame::appendSegment(const QPointF &pos)
+{
+    m_snake.append(pos);
+    m_bodyGrid.insert(m_headSerial - (m_snake.size() - 1), pos);
+}
+
+/**
+ * @brief Удаляет последний сегмент змейки из сетки и из m_snake
+ */
+void SnakeGame::removeTailSegment()
+{
+    m_bodyGrid.remove(m_headSerial - (m_snake.size() - 1), m_snake.last());
+    m_snake.removeLast();
 }
 
 /**
@@ -324,6 +732,7 @@ void SnakeGame::timerEvent(QTimerEvent *event)
     Q_UNUSED(event);
     
     if (m_inGame && !m_isPaused) {
+        processInput(m_inputClock.nsecsElapsed()); // Применение ввода за прошедший такт
         move();             // Перемещение змейки
         checkCollision();   // Проверка столкновений
         repaint();          // Перерисовка окна
@@ -372,6 +781,7 @@ void SnakeGame::handleBoundaryTeleportation()
     for (int i = 0; i < m_snake.size(); i++) {
         QPointF &segment = m_snake[i];
         QPointF &visualSegment = m_visualSnake[i];
+        const QPointF before = segment;
         
         // Телепортация логических позиций
         if (segment.x() < -DOT_SIZE * 3) segment.setX(width() + DOT_SIZE * 2);
@@ -380,6 +790,10 @@ void SnakeGame::handleBoundaryTeleportation()
         if (segment.y() < -DOT_SIZE * 3) segment.setY(height() + DOT_SIZE * 2);
         else if (segment.y() > height() + DOT_SIZE * 3) segment.setY(-DOT_SIZE * 2);
         
+        if (segment != before) {
+            m_bodyGrid.move(m_headSerial - i, before, segment);
+        }
+        
         // Телепортация визуальных позиций
         if (visualSegment.x() < -DOT_SIZE * 3) visualSegment.setX(width() + DOT_SIZE * 2);
         else if (visualSegment.x() > width() + DOT_SIZE * 3) visualSegment.setX(-DOT_SIZE * 2);
@@ -403,90 +817,384 @@ void SnakeGame::paintEvent(QPaintEvent *event)
     Q_UNUSED(event);
     
     QPainter painter(this);
-    painter.setRenderHint(QPainter::Antialiasing);
     
-    // Отрисовка фона
-    painter.fillRect(rect(), Qt::white);
+    if (m_inGame && m_renderBackend == RenderBackend::Software) {
+        // Сцена собирается блиттером в буфере кадра и выводится одним вызовом
+        renderSceneSoftware();
+        painter.drawImage(0, 0, m_frameBuffer);
+        painter.setRenderHint(QPainter::Antialiasing);
+    } else {
+        painter.setRenderHint(QPainter::Antialiasing);
+        
+        // Отрисовка фона
+        painter.fillRect(rect(), Qt::white);
+    }
     
     // Отрисовка границ поля
     painter.setPen(QPen(Qt::gray, 1, Qt::DashLine));
     painter.drawRect(rect().adjusted(0, 0, -1, -1));
     
     if (m_inGame) {
-        // ████████████████████████████████████████████████████████████████████████
-        // АФФИННЫЕ ПРЕОБРАЗОВАНИЯ ДЛЯ ЯБЛОКА: вращение + масштабирование
-        // ████████████████████████████████████████████████████████████████████████
-        QTransform appleTransform;
-        appleTransform.translate(m_applePos.x() + DOT_SIZE / 2, m_applePos.y() + DOT_SIZE / 2);
-        appleTransform.rotate(QDateTime::currentMSecsSinceEpoch() / 20.0); // Вращение
-        appleTransform.scale(1.1, 1.1); // Масштабирование
-        appleTransform.translate(-DOT_SIZE / 2, -DOT_SIZE / 2);
-        
-        painter.setTransform(appleTransform);
-        painter.drawImage(0, 0, m_appleImage);
-        painter.resetTransform();
-        
-        // Отрисовка змейки с аффинными преобразованиями
-        for (int i = 0; i < m_visualSnake.size(); i++) {
-            if (i == 0) {
-                // ████████████████████████████████████████████████████████████████████████
-                // АФФИННЫЕ ПРЕОБРАЗОВАНИЯ ДЛЯ ГОЛОВЫ: поворот
-                // ████████████████████████████████████████████████████████████████████████
-                QTransform headTransform;
-                headTransform.translate(m_visualSnake[i].x() + DOT_SIZE / 2, 
+        if (m_renderBackend == RenderBackend::Painter) {
+            drawSceneWithPainter(painter);
+        }
+        drawHud(painter);
+    } else {
+        gameOverScreen(painter);
+    }
+    
+    if (m_isPaused) {
+        painter.setFont(QFont("Arial", 28, QFont::Bold));
+        painter.setPen(Qt::blue);
+        painter.drawText(rect(), Qt::AlignCenter, "PAUSED");
+    }
+    
+    recordInputLatency();
+}
+
+/**
+ * @brief Отрисовывает яблоко и змейку через QPainter
+ */
+void SnakeGame::drawSceneWithPainter(QPainter &painter)
+{
+    // ████████████████████████████████████████████████████████████████████████
+    // АФФИННЫЕ ПРЕОБРАЗОВАНИЯ ДЛЯ ЯБЛОКА: вращение + масштабирование
+    // ████████████████████████████████████████████████████████████████████████
+    QTransform appleTransform;
+    appleTransform.translate(m_applePos.x() + DOT_SIZE / 2, m_applePos.y() + DOT_SIZE / 2);
+    appleTransform.rotate(appleRotation()); // Вращение
+    appleTransform.scale(1.1, 1.1); // Масштабирование
+    appleTransform.translate(-DOT_SIZE / 2, -DOT_SIZE / 2);
+    
+    painter.setTransform(appleTransform);
+    painter.drawImage(0, 0, m_appleImage);
+    painter.resetTransform();
+    
+    if (m_bodyStyle == BodyStyle::SmoothPath) {
+        strokeBodyPath(painter);
+    }
+    
+    // Отрисовка змейки с аффинными преобразованиями
+    for (int i = 0; i < m_visualSnake.size(); i++) {
+        if (i == 0) {
+            // ████████████████████████████████████████████████████████████████████████
+            // АФФИННЫЕ ПРЕОБРАЗОВАНИЯ ДЛЯ ГОЛОВЫ: поворот
+            // ████████████████████████████████████████████████████████████████████████
+            QTransform headTransform;
+            headTransform.translate(m_visualSnake[i].x() + DOT_SIZE / 2, 
+                                  m_visualSnake[i].y() + DOT_SIZE / 2);
+            headTransform.rotate(m_currentHeadAngle * 180 / M_PI);
+            headTransform.translate(-DOT_SIZE / 2, -DOT_SIZE / 2);
+            
+            painter.setTransform(headTransform);
+            painter.drawImage(0, 0, m_headImage);
+            painter.resetTransform();
+        } else if (m_bodyStyle == BodyStyle::SmoothPath) {
+            break; // Тело уже нарисовано одним контуром
+        } else {
+            // ████████████████████████████████████████████████████████████████████████
+            // АФФИННЫЕ ПРЕОБРАЗОВАНИЯ ДЛЯ ТЕЛА: масштабирование + изменение формы
+            // ████████████████████████████████████████████████████████████████████████
+            if (i > 0 && i < m_visualSnake.size() - 1) {
+                QTransform bodyTransform;
+                const qreal scale = 0.9 + 0.1 * (i % 2); // Чередующееся масштабирование
+                bodyTransform.translate(m_visualSnake[i].x() + DOT_SIZE / 2, 
                                       m_visualSnake[i].y() + DOT_SIZE / 2);
-                headTransform.rotate(m_currentHeadAngle * 180 / M_PI);
-                headTransform.translate(-DOT_SIZE / 2, -DOT_SIZE / 2);
+                bodyTransform.scale(scale, scale); // Изменение формы
+                bodyTransform.translate(-DOT_SIZE / 2, -DOT_SIZE / 2);
                 
-                painter.setTransform(headTransform);
-                painter.drawImage(0, 0, m_headImage);
+                painter.setTransform(bodyTransform);
+                painter.drawImage(0, 0, m_dotImage);
                 painter.resetTransform();
             } else {
-                // ████████████████████████████████████████████████████████████████████████
-                // АФФИННЫЕ ПРЕОБРАЗОВАНИЯ ДЛЯ ТЕЛА: масштабирование + изменение формы
-                // ████████████████████████████████████████████████████████████████████████
-                if (i > 0 && i < m_visualSnake.size() - 1) {
-                    QTransform bodyTransform;
-                    const qreal scale = 0.9 + 0.1 * (i % 2); // Чередующееся масштабирование
-                    bodyTransform.translate(m_visualSnake[i].x() + DOT_SIZE / 2, 
-                                          m_visualSnake[i].y() + DOT_SIZE / 2);
-                    bodyTransform.scale(scale, scale); // Изменение формы
-                    bodyTransform.translate(-DOT_SIZE / 2, -DOT_SIZE / 2);
-                    
-                    painter.setTransform(bodyTransform);
-                    painter.drawImage(0, 0, m_dotImage);
-                    painter.resetTransform();
-                } else {
-                    painter.drawImage(m_visualSnake[i], m_dotImage);
-                }
+                painter.drawImage(m_visualSnake[i], m_dotImage);
             }
         }
+    }
+}
+
+/**
+ * @brief Собирает кадр программным блиттером
+ *
+ * Использует заранее повернутые спрайты, поэтому на каждый сегмент
+ * приходится только перенос строк со смешиванием, без состояния QPainter.
+ * Порядок наложения совпадает с drawSceneWithPainter().
+ */
+void SnakeGame::renderSceneSoftware()
+{
+    if (m_frameBuffer.size() != size()) {
+        prepareSoftwareSprites();
+    }
+    
+    m_frameBuffer.fill(Qt::white);
+    
+    // Наложение кадра по центру спрайта
+    auto blitCentered = [this](const QImage &frame, const QPointF &pos) {
+        SpriteBlitter::blend(m_frameBuffer, frame,
+                             qRound(pos.x() + DOT_SIZE / 2) - SPRITE_CANVAS / 2,
+                             qRound(pos.y() + DOT_SIZE / 2) - SPRITE_CANVAS / 2);
+    };
+    
+    blitCentered(m_appleFrames[rotationFrameIndex(appleRotation(), ROTATION_STEPS)], m_applePos);
+    
+    if (m_bodyStyle == BodyStyle::SmoothPath) {
+        QPainter framePainter(&m_frameBuffer);
+        framePainter.setRenderHint(QPainter::Antialiasing);
+        strokeBodyPath(framePainter);
+    }
+    
+    for (int i = 0; i < m_visualSnake.size(); i++) {
+        if (i == 0) {
+            blitCentered(m_headFrames[rotationFrameIndex(m_currentHeadAngle * 180 / M_PI, ROTATION_STEPS)],
+                         m_visualSnake[i]);
+        } else if (m_bodyStyle == BodyStyle::SmoothPath) {
+            break;
+        } else if (i < m_visualSnake.size() - 1) {
+            blitCentered(m_bodyFrames[i % 2], m_visualSnake[i]);
+        } else {
+            blitCentered(m_bodyFrames[1], m_visualSnake[i]);
+        }
+    }
+}
+
+/**
+ * @brief Перестраивает сглаженный контур тела по визуальным позициям
+ *
+ * Сегменты соединяются сплайном Катмулла-Рома, переведенным в кубические
+ * кривые Безье. Визуальные позиции интерполируются каждый такт целиком,
+ * поэтому контур перестраивается полностью, но в уже выделенную память
+ * (начиная с Qt 5.13).
+ * На участке телепортации через границу контур разрывается.
+ */
+void SnakeGame::rebuildBodyPath()
+{
+    const int count = m_visualSnake.size();
+    
+    // clear() и reserve() появились в Qt 5.13; в более старых версиях
+    // контур создается заново, с выделением памяти на каждом такте
+#if QT_VERSION >= QT_VERSION_CHECK(5, 13, 0)
+    m_bodyPath.clear();
+    if (count < 2) return;
+    m_bodyPath.reserve(count * 3 + 1);
+#else
+    m_bodyPath = QPainterPath();
+    if (count < 2) return;
+#endif
+    
+    const QPointF offset(DOT_SIZE / 2, DOT_SIZE / 2);
+    const qreal breakDistance = SEGMENT_DISTANCE * 3;
+    
+    auto point = [&](int i) { return m_visualSnake[qBound(0, i, count - 1)] + offset; };
+    auto isNear = [&](const QPointF &a, const QPointF &b) {
+        return (a - b).manhattanLength() < breakDistance;
+    };
+    
+    m_bodyPath.moveTo(point(0));
+    for (int i = 0; i + 1 < count; i++) {
+        const QPointF p1 = point(i);
+        const QPointF p2 = point(i + 1);
         
-        // Отрисовка игровой информации
-        painter.setFont(QFont("Arial", 12));
-        painter.setPen(Qt::black);
-        painter.drawText(10, 20, QString("Score: %1").arg(m_score));
-        painter.drawText(10, 40, QString("Speed: %1").arg(m_currentSpeed, 0, 'f', 1));
-        painter.drawText(10, 60, QString("Length: %1").arg(m_snake.size()));
-        painter.drawText(10, 80, QString("Angle: %1°").arg(int(m_currentHeadAngle * 180 / M_PI)));
+        if (!isNear(p1, p2)) {
+            m_bodyPath.moveTo(p2);
+            continue;
+        }
         
-    } else {
-        gameOverScreen(painter);
+        // Соседние точки за разрывом не должны влиять на касательные
+        QPointF p0 = point(i - 1);
+        QPointF p3 = point(i + 2);
+        if (!isNear(p0, p1)) p0 = p1;
+        if (!isNear(p2, p3)) p3 = p2;
+        
+        m_bodyPath.cubicTo(p1 + (p2 - p0) / 6, p2 - (p3 - p1) / 6, p2);
     }
+}
+
+/**
+ * @brief Рисует сглаженный контур тела одним вызовом
+ */
+void SnakeGame::strokeBodyPath(QPainter &painter)
+{
+    const QPen pen(Qt::green, DOT_SIZE, Qt::SolidLine, Qt::RoundCap, Qt::RoundJoin);
+    painter.strokePath(m_bodyPath, pen);
+}
+
+/**
+ * @brief Отрисовывает игровую информацию
+ */
+void SnakeGame::drawHud(QPainter &painter)
+{
+    painter.setFont(QFont("Arial", 12));
+    painter.setPen(Qt::black);
+    painter.drawText(10, 20, QString("Score: %1").arg(m_score));
+    painter.drawText(10, 40, QString("Speed: %1").arg(m_currentSpeed, 0, 'f', 1));
+    painter.drawText(10, 60, QString("Length: %1").arg(m_snake.size()));
+    painter.drawText(10, 80, QString("Angle: %1°").arg(int(m_currentHeadAngle * 180 / M_PI)));
     
-    if (m_isPaused) {
-        painter.setFont(QFont("Arial", 28, QFont::Bold));
-        painter.setPen(Qt::blue);
-        painter.drawText(rect(), Qt::AlignCenter, "PAUSED");
+    // Задержка от нажатия клавиши до кадра с результатом
+    // Статистика пересчитывается в recordInputLatency() только при новых замерах
+    if (!m_latencySamples.isEmpty()) {
+        painter.drawText(10, 100, QString("Input latency: %1 ms (p95 %2 ms)")
+                                      .arg(m_latencyAverage, 0, 'f', 1).arg(m_latencyP95, 0, 'f', 1));
+    }
+}
+
+/**
+ * @brief Сопоставляет клавишу органу управления
+ * @return false, если клавиша не управляет движением
+ */
+bool SnakeGame::keyToControl(int key, Control &control) const
+{
+    switch (key) {
+        case Qt::Key_Left:
+        case Qt::Key_A:
+            control = ControlTurnLeft;
+            return true;
+        case Qt::Key_Right:
+        case Qt::Key_D:
+            control = ControlTurnRight;
+            return true;
+        case Qt::Key_Up:
+        case Qt::Key_W:
+            control = ControlAccelerate;
+            return true;
+        case Qt::Key_Down:
+        case Qt::Key_S:
+            control = ControlDecelerate;
+            return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Возвращает флаг удержания органа управления
+ */
+bool &SnakeGame::controlFlag(Control control)
+{
+    switch (control) {
+        case ControlTurnLeft: return m_turningLeft;
+        case ControlTurnRight: return m_turningRight;
+        case ControlAccelerate: return m_accelerating;
+        default: return m_decelerating;
     }
 }
 
+/**
+ * @brief Ставит нажатие или отпускание в очередь с меткой времени
+ * 
+ * Метка берется в момент доставки события виджету по m_inputClock,
+ * тем же часам, по которым отсчитываются такты.
+ */
+void SnakeGame::queueInput(Control control, bool pressed)
+{
+    m_inputQueue.append({m_inputClock.nsecsElapsed(), control, pressed});
+}
+
+/**
+ * @brief Применяет очередь ввода к такту, заканчивающемуся в tickEnd
+ * 
+ * Для каждого органа управления считается доля такта, в течение которой
+ * клавиша была нажата, с учетом точного времени событий. Поэтому нажатие
+ * короче такта не теряется, а поворот не зависит от того, в какой момент
+ * такта пришло событие.
+ */
+void SnakeGame::processInput(qint64 tickEnd)
+{
+    const qint64 tickStart = qMin(m_lastTickTime, tickEnd);
+    const qint64 duration = tickEnd - tickStart;
+    
+    qint64 heldTime[ControlCount] = {};
+    qint64 segmentStart[ControlCount];
+    for (int c = 0; c < ControlCount; c++) {
+        segmentStart[c] = tickStart;
+    }
+    
+    int processed = 0;
+    for (; processed < m_inputQueue.size(); processed++) {
+        const InputEvent &event = m_inputQueue[processed];
+        if (event.time > tickEnd) break;
+        
+        bool &held = controlFlag(event.control);
+        if (held == event.pressed) continue;
+        
+        const qint64 time = qBound(tickStart, event.time, tickEnd);
+        if (held) {
+            heldTime[event.control] += time - segmentStart[event.control];
+        }
+        segmentStart[event.control] = time;
+        held = event.pressed;
+        m_appliedInputTimes.append(event.time);
+    }
+    m_inputQueue.remove(0, processed);
+    
+    qreal amounts[ControlCount];
+    for (int c = 0; c < ControlCount; c++) {
+        const bool held = controlFlag(Control(c));
+        if (held) {
+            heldTime[c] += tickEnd - segmentStart[c];
+        }
+        amounts[c] = duration > 0 ? qreal(heldTime[c]) / duration : (held ? 1.0 : 0.0);
+    }
+    
+    m_lastTickTime = tickEnd;
+    applyControls(amounts);
+}
+
+/**
+ * @brief Применяет управление с долями такта для каждого органа
+ */
+void SnakeGame::applyControls(const qreal amounts[ControlCount])
+{
+    if (amounts[ControlTurnLeft] > 0) turnLeft(amounts[ControlTurnLeft]);
+    if (amounts[ControlTurnRight] > 0) turnRight(amounts[ControlTurnRight]);
+    if (amounts[ControlAccelerate] > 0) accelerate(amounts[ControlAccelerate]);
+    if (amounts[ControlDecelerate] > 0) decelerate(amounts[ControlDecelerate]);
+}
+
+/**
+ * @brief Записывает задержку для событий ввода, результат которых только что отрисован
+ */
+void SnakeGame::recordInputLatency()
+{
+    if (m_appliedInputTimes.isEmpty()) return;
+    
+    const qint64 now = m_inputClock.nsecsElapsed();
+    for (qint64 time : m_appliedInputTimes) {
+        if (m_latencySamples.size() < LATENCY_SAMPLES) {
+            m_latencySamples.append(now - time);
+        } else {
+            m_latencySamples[m_latencyIndex] = now - time;
+            m_latencyIndex = (m_latencyIndex + 1) % LATENCY_SAMPLES;
+        }
+    }
+    m_appliedInputTimes.clear();
+    
+    // Сортировка в заранее выделенный буфер: без выделений памяти в такте
+    m_latencySorted.resize(m_latencySamples.size());
+    std::copy(m_latencySamples.cbegin(), m_latencySamples.cend(), m_latencySorted.begin());
+    std::sort(m_latencySorted.begin(), m_latencySorted.end());
+    
+    qint64 total = 0;
+    for (qint64 sample : m_latencySorted) total += sample;
+    
+    const int count = m_latencySorted.size();
+    m_latencyAverage = total / 1e6 / count;
+    m_latencyP95 = m_latencySorted[qMin(count - 1, count * 95 / 100)] / 1e6;
+}
+
 /**
  * @brief Выполняет поворот змейки влево
  */
-void SnakeGame::turnLeft()
+void SnakeGame::turnLeft(qreal amount)
 {
-    m_directionAngle -= TURN_SPEED;
+    if (m_fixedPoint) {
+        // Беззнаковый угол переполняется по модулю оборота - нормализация не нужна
+        static const qint64 turnStep = FixedMath::angleFromRadians(TURN_SPEED);
+        m_fixedAngle -= FixedMath::Angle((turnStep * FixedMath::fromReal(amount)) >> FixedMath::FRACTION_BITS);
+        m_directionAngle = FixedMath::angleToRadians(m_fixedAngle);
+        return;
+    }
+    
+    m_directionAngle -= TURN_SPEED * amount;
     // Нормализация угла
     while (m_directionAngle < 0) m_directionAngle += 2 * M_PI;
 }
@@ -494,9 +1202,16 @@ void SnakeGame::turnLeft()
 /**
  * @brief Выполняет поворот змейки вправо
  */
-void SnakeGame::turnRight()
+void SnakeGame::turnRight(qreal amount)
 {
-    m_directionAngle += TURN_SPEED;
+    if (m_fixedPoint) {
+        static const qint64 turnStep = FixedMath::angleFromRadians(TURN_SPEED);
+        m_fixedAngle += FixedMath::Angle((turnStep * FixedMath::fromReal(amount)) >> FixedMath::FRACTION_BITS);
+        m_directionAngle = FixedMath::angleToRadians(m_fixedAngle);
+        return;
+    }
+    
+    m_directionAngle += TURN_SPEED * amount;
     // Нормализация угла
     while (m_directionAngle >= 2 * M_PI) m_directionAngle -= 2 * M_PI;
 }
@@ -504,17 +1219,31 @@ void SnakeGame::turnRight()
 /**
  * @brief Увеличивает скорость движения змейки
  */
-void SnakeGame::accelerate()
+void SnakeGame::accelerate(qreal amount)
 {
-    m_currentSpeed = qMin(m_currentSpeed + ACCELERATION, MAX_SPEED);
+    if (m_fixedPoint) {
+        const FixedMath::Fixed step = FixedMath::mul(FixedMath::fromReal(ACCELERATION), FixedMath::fromReal(amount));
+        m_fixedSpeed = qMin(m_fixedSpeed + step, FixedMath::fromReal(MAX_SPEED));
+        m_currentSpeed = FixedMath::toReal(m_fixedSpeed);
+        return;
+    }
+    
+    m_currentSpeed = qMin(m_currentSpeed + ACCELERATION * amount, MAX_SPEED);
 }
 
 /**
  * @brief Уменьшает скорость движения змейки
  */
-void SnakeGame::decelerate()
+void SnakeGame::decelerate(qreal amount)
 {
-    m_currentSpeed = qMax(m_currentSpeed - ACCELERATION * 2, 0.0);
+    if (m_fixedPoint) {
+        const FixedMath::Fixed step = FixedMath::mul(FixedMath::fromReal(ACCELERATION * 2), FixedMath::fromReal(amount));
+        m_fixedSpeed = qMax(m_fixedSpeed - step, 0);
+        m_currentSpeed = FixedMath::toReal(m_fixedSpeed);
+        return;
+    }
+    
+    m_currentSpeed = qMax(m_currentSpeed - ACCELERATION * 2 * amount, 0.0);
 }
 
 /**
@@ -524,24 +1253,10 @@ void SnakeGame::keyPressEvent(QKeyEvent *event)
 {
     const int key = event->key();
     
-    // Управление движением (стрелки и WASD)
-    switch (key) {
-        case Qt::Key_Left:
-        case Qt::Key_A:
-            m_turningLeft = true;
-            break;
-        case Qt::Key_Right:
-        case Qt::Key_D:
-            m_turningRight = true;
-            break;
-        case Qt::Key_Up:
-        case Qt::Key_W:
-            m_accelerating = true;
-            break;
-        case Qt::Key_Down:
-        case Qt::Key_S:
-            m_decelerating = true;
-            break;
+    // Управление движением (стрелки и WASD) через очередь ввода
+    Control control;
+    if (!event->isAutoRepeat() && keyToControl(key, control)) {
+        queueInput(control, true);
     }
     
     // Управление игрой
@@ -571,24 +1286,10 @@ void SnakeGame::keyReleaseEvent(QKeyEvent *event)
 {
     const int key = event->key();
     
-    // Сброс флагов управления
-    switch (key) {
-        case Qt::Key_Left:
-        case Qt::Key_A:
-            m_turningLeft = false;
-            break;
-        case Qt::Key_Right:
-        case Qt::Key_D:
-            m_turningRight = false;
-            break;
-        case Qt::Key_Up:
-        case Qt::Key_W:
-            m_accelerating = false;
-            break;
-        case Qt::Key_Down:
-        case Qt::Key_S:
-            m_decelerating = false;
-            break;
+    // Отпускание органа управления через очередь ввода
+    Control control;
+    if (!event->isAutoRepeat() && keyToControl(key, control)) {
+        queueInput(control, false);
     }
     
     QWidget::keyReleaseEvent(event);
@@ -614,6 +1315,7 @@ void SnakeGame::resumeGame()
 {
     if (m_inGame && m_isPaused) {
         m_timerId = startTimer(DELAY);
+        m_lastTickTime = m_inputClock.nsecsElapsed(); // Время паузы не считается удержанием
         m_isPaused = false;
         emit gameResumed();
     }
@@ -9,6 +9,12 @@
 #include <QTimerEvent>
 #include <QTransform>
 #include <QDateTime>
+#include <QPainterPath>
+#include <QFutureWatcher>
+#include <QRandomGenerator>
+#include <QElapsedTimer>
+#include "spatial_grid.h"
+#include "fixed_math.h"
 
 /**
  * @class SnakeGame
@@ -31,6 +37,48 @@ public:
     void resumeGame();
     bool isGameActive() const { return m_inGame; }
 
+    /// Бэкенд отрисовки игрового поля
+    enum class RenderBackend {
+        Painter,    ///< Отрисовка каждого спрайта через QPainter
+        Software    ///< Программный блиттер в буфер кадра QImage
+    };
+
+    void setRenderBackend(RenderBackend backend);
+    RenderBackend renderBackend() const { return m_renderBackend; }
+
+    /// Способ отрисовки тела змейки
+    enum class BodyStyle {
+        Sprites,    ///< Отдельный спрайт на каждый сегмент
+        SmoothPath  ///< Единый сглаженный контур, рисуемый одним вызовом
+    };
+
+    void setBodyStyle(BodyStyle style);
+    BodyStyle bodyStyle() const { return m_bodyStyle; }
+
+    // Детерминированная целочисленная симуляция (вступает в силу при initGame)
+    void setFixedPointMath(bool enabled) { m_fixedPoint = enabled; }
+    bool isFixedPointMath() const { return m_fixedPoint; }
+
+    // Безголовый режим: бенчмарк и обучающий прогон PGO
+    void startHeadless(quint32 seed);
+    void step();
+    static int tickDelay() { return DELAY; }    ///< Длительность такта игры (мс)
+    int snakeLength() const { return m_snake.size(); }              ///< Количество сегментов
+    int headlessRestarts() const { return m_headlessRestarts; }  ///< Перезапусков с startHeadless()
+    qint64 stateFootprint() const;                ///< Память состояния и буферов отрисовки (байт)
+
+    /// Сводка состояния симуляции для сравнения прогонов разных сборок
+    struct StateDigest {
+        int score;                  ///< Счет
+        int length;                 ///< Количество сегментов
+        FixedMath::Fixed headX;     ///< Позиция головы в Q16.16
+        FixedMath::Fixed headY;
+        FixedMath::Angle angle;     ///< Угол направления в режиме фиксированной точки
+        quint64 bodyHash;           ///< FNV-1a координат всех сегментов в Q16.16
+    };
+
+    StateDigest stateDigest() const;
+
 signals:
     void gameOver();
     void scoreChanged(int score);
@@ -48,19 +96,55 @@ protected:
 private:
     // Основные методы игры (требования задания)
     void loadImages();           ///< Загружает изображения элементов игры
+    void onAppleImageLoaded();   ///< Подставляет загруженное в фоне изображение яблока
     void locateApple();          ///< Размещает яблоко на игровом поле
     void move();                 ///< Управляет движением змейки с использованием матриц
     void checkCollision();       ///< Проверяет столкновения змейки
+    void autopilot();            ///< Ведет змейку к яблоку в безголовом режиме
     
     // Вспомогательные методы
     void gameOverScreen(QPainter &painter);
+    void drawSceneWithPainter(QPainter &painter);
+    void renderSceneSoftware();
+    void prepareSoftwareSprites();
+    void drawHud(QPainter &painter);
+    void rebuildBodyPath();
+    void strokeBodyPath(QPainter &painter);
     void handleBoundaryTeleportation();
+    void appendSegment(const QPointF &pos);
+    void removeTailSegment();
+    bool sweptBodyHit(const QPointF &from, const QPointF &to) const;
+    bool isNearPath(const QPointF &point, const QPointF &from, const QPointF &to, qreal radius) const;
     
-    // Методы управления движением
-    void turnLeft();
-    void turnRight();
-    void accelerate();
-    void decelerate();
+    /// Органы управления, для которых ведется очередь ввода
+    enum Control {
+        ControlTurnLeft,
+        ControlTurnRight,
+        ControlAccelerate,
+        ControlDecelerate,
+        ControlCount
+    };
+
+    /// Событие ввода с моментом нажатия или отпускания
+    struct InputEvent {
+        qint64 time;                                 ///< Время события по m_inputClock (нс)
+        Control control;                             ///< Орган управления
+        bool pressed;                                ///< Нажатие (true) или отпускание (false)
+    };
+
+    // Методы обработки ввода
+    bool keyToControl(int key, Control &control) const;
+    bool &controlFlag(Control control);
+    void queueInput(Control control, bool pressed);
+    void processInput(qint64 tickEnd);
+    void applyControls(const qreal amounts[ControlCount]);
+    void recordInputLatency();
+
+    // Методы управления движением (amount - доля такта, в течение которой нажата клавиша)
+    void turnLeft(qreal amount = 1.0);
+    void turnRight(qreal amount = 1.0);
+    void accelerate(qreal amount = 1.0);
+    void decelerate(qreal amount = 1.0);
 
     // Игровые константы
     static const int DOT_SIZE = 10;                  ///< Размер сегмента змейки и яблока
@@ -70,12 +154,20 @@ private:
     static constexpr qreal TURN_SPEED = 0.08;        ///< Скорость поворота в радианах за кадр
     static constexpr qreal SEGMENT_DISTANCE = 8.0;   ///< Фиксированное расстояние между сегментами
     static constexpr qreal SMOOTHNESS = 0.1;         ///< Коэффициент плавности интерполяции
+    static const int ROTATION_STEPS = 64;            ///< Число заранее повернутых кадров спрайта
+    static const int SPRITE_CANVAS = DOT_SIZE * 2;   ///< Размер холста повернутого спрайта
+    static const int LATENCY_SAMPLES = 120;          ///< Размер окна статистики задержки ввода
+    static const int AUTOPILOT_STALL_TICKS = 300;    ///< Тактов без яблока до его переноса автопилотом
 
     // Игровое состояние
     int m_timerId;                                   ///< ID таймера для игрового цикла
     int m_score;                                     ///< Текущий счет игрока
     bool m_inGame;                                   ///< Флаг активности игры
     bool m_isPaused;                                 ///< Флаг паузы игры
+    bool m_headless;                                 ///< Игра управляется step() без таймера
+    int m_autopilotIdleTicks;                        ///< Тактов автопилота без съеденного яблока
+    int m_headlessRestarts;                          ///< Перезапусков после столкновения в step()
+    QRandomGenerator m_random;                       ///< Генератор позиций яблока
 
     // Переменные движения и преобразований
     qreal m_directionAngle;                          ///< Текущий угол направления движения (радианы)
@@ -86,20 +178,52 @@ private:
     qreal m_interpolationFactor;                     ///< Фактор интерполяции для плавности
     QTransform m_movementTransform;                  ///< Матрица для аффинных преобразований движения
 
+    // Целочисленное состояние движения (при m_fixedPoint вещественные поля выше - его копии)
+    bool m_fixedPoint;                               ///< Симуляция в фиксированной точке
+    FixedMath::Angle m_fixedAngle;                   ///< Угол направления движения
+    FixedMath::Fixed m_fixedSpeed;                   ///< Скорость движения
+    FixedMath::Fixed m_fixedProgress;                ///< Прогресс движения до следующего сегмента
+
     // Состояние управления
     bool m_turningLeft;                              ///< Флаг поворота влево
     bool m_turningRight;                             ///< Флаг поворота вправо
     bool m_accelerating;                             ///< Флаг ускорения
     bool m_decelerating;                             ///< Флаг торможения
 
+    // Очередь ввода и задержка "клавиша - кадр"
+    QElapsedTimer m_inputClock;                      ///< Часы для меток времени ввода
+    qint64 m_lastTickTime;                           ///< Время конца предыдущего такта (нс)
+    QVector<InputEvent> m_inputQueue;                ///< Еще не примененные события ввода
+    QVector<qint64> m_appliedInputTimes;             ///< События, примененные после последнего кадра
+    QVector<qint64> m_latencySamples;                ///< Кольцевой буфер задержек (нс)
+    int m_latencyIndex;                              ///< Позиция записи в m_latencySamples
+    QVector<qint64> m_latencySorted;                 ///< Рабочий буфер сортировки для перцентиля
+    qreal m_latencyAverage;                          ///< Средняя задержка ввода (мс) для HUD
+    qreal m_latencyP95;                              ///< 95-й перцентиль задержки ввода (мс) для HUD
+
     // Данные змейки и яблока
     QVector<QPointF> m_snake;                        ///< Логические позиции сегментов змейки
     QVector<QPointF> m_visualSnake;                  ///< Визуальные позиции для плавного отображения
     QVector<QPointF> m_targetPositions;              ///< Целевые позиции для интерполяции
     QPointF m_applePos;                              ///< Позиция яблока на поле
+    QPointF m_previousHead;                          ///< Позиция головы до текущего такта
+    SpatialGrid m_bodyGrid;                          ///< Сетка сегментов m_snake для поиска столкновений
+    int m_headSerial;                                ///< Номер головы; сегмент i хранится в сетке как m_headSerial - i
     
     // Изображения элементов игры
     QImage m_dotImage;                               ///< Изображение сегмента тела змейки
     QImage m_headImage;                              ///< Изображение головы змейки
     QImage m_appleImage;                             ///< Изображение яблока
+    QFutureWatcher<QImage> m_appleLoader;            ///< Фоновая загрузка изображения яблока
+
+    // Программный бэкенд отрисовки
+    RenderBackend m_renderBackend;                   ///< Выбранный бэкенд отрисовки
+    QImage m_frameBuffer;                            ///< Буфер кадра программного бэкенда
+    QVector<QImage> m_headFrames;                    ///< Повернутые кадры головы
+    QVector<QImage> m_appleFrames;                   ///< Повернутые и масштабированные кадры яблока
+    QImage m_bodyFrames[2];                          ///< Кадры тела с чередующимся масштабом
+
+    // Сглаженное тело
+    BodyStyle m_bodyStyle;                           ///< Выбранный способ отрисовки тела
+    QPainterPath m_bodyPath;                         ///< Сплайн тела, перестраивается раз в такт
 };
\ No newline at end of file
@@ -9,8 +9,8 @@ SnakeMenu::SnakeMenu(QWidget *parent) : QWidget(parent),
     controlsLabel(nullptr),
     menuLayout(nullptr)
 {
+    // Оформление задается единой таблицей стилей приложения (style.qss)
     setFixedSize(600, 600);
-    setStyleSheet("background-color: white; color: black;");
     
     // Создаем вертикальный layout для меню
     menuLayout = new QVBoxLayout(this);
@@ -18,7 +18,7 @@ SnakeMenu::SnakeMenu(QWidget *parent) : QWidget(parent),
     // Заголовок игры
     titleLabel = new QLabel("SNAKE GAME", this);
     titleLabel->setAlignment(Qt::AlignCenter);
-    titleLabel->setStyleSheet("font-size: 28px; font-weight: bold; margin: 20px;");
+    titleLabel->setObjectName("titleLabel");
     
     // Информация об управлении
     controlsLabel = new QLabel(
@@ -32,35 +32,15 @@ SnakeMenu::SnakeMenu(QWidget *parent) : QWidget(parent),
         this
     );
     controlsLabel->setAlignment(Qt::AlignCenter);
-    controlsLabel->setStyleSheet("font-size: 16px; margin: 20px;");
+    controlsLabel->setObjectName("controlsLabel");
     
     // Кнопка начала игры
     startButton = new QPushButton("Начать игру", this);
-    startButton->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #4CAF50;"
-        "  border: none;"
-        "  color: white;"
-        "  padding: 15px;"
-        "  font-size: 18px;"
-        "  margin: 10px;"
-        "}"
-        "QPushButton:hover { background-color: #45a049; }"
-    );
+    startButton->setObjectName("startButton");
     
     // Кнопка выхода из игры
     quitButton = new QPushButton("Выход", this);
-    quitButton->setStyleSheet(
-        "QPushButton {"
-        "  background-color: #f44336;"
-        "  border: none;"
-        "  color: white;"
-        "  padding: 15px;"
-        "  font-size: 18px;"
-        "  margin: 10px;"
-        "}"
-        "QPushButton:hover { background-color: #da190b; }"
-    );
+    quitButton->setObjectName("quitButton");
     
     // Добавляем элементы в layout
     menuLayout->addStretch();
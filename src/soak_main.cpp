@@ -0,0 +1,276 @@
+#include "snake_game.h"
+#include "benchmark.h"
+#include <QApplication>
+#include <QFile>
+#include <QImage>
+#include <QTextStream>
+#include <QVector>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#if defined(Q_OS_WIN)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(Q_OS_LINUX)
+#include <unistd.h>
+#endif
+
+// ████████████████████████████████████████████████████████████████████████
+// ПОДСЧЕТ ВЫДЕЛЕНИЙ ПАМЯТИ
+// ████████████████████████████████████████████████████████████████████████
+
+static std::atomic<quint64> g_allocations(0);
+
+#if defined(__GLIBC__)
+// Контейнеры Qt выделяют память через malloc, поэтому на glibc перехватывается
+// само семейство malloc (operator new тоже идет через него)
+extern "C" {
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t count, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+
+void *malloc(size_t size) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) noexcept
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    return __libc_realloc(ptr, size);
+}
+}
+#else
+// На остальных платформах считаются только выделения через operator new
+void *operator new(size_t size)
+{
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+#endif
+
+// ████████████████████████████████████████████████████████████████████████
+// ИЗМЕРЕНИЯ
+// ████████████████████████████████████████████████████████████████████████
+
+// Резидентная память процесса в байтах (0, если платформа не поддерживается)
+static qint64 residentMemory()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return qint64(counters.WorkingSetSize);
+    }
+    return 0;
+#elif defined(Q_OS_LINUX)
+    long pages = 0;
+    long resident = 0;
+    FILE *statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    const int fields = std::fscanf(statm, "%ld %ld", &pages, &resident);
+    std::fclose(statm);
+    return fields == 2 ? qint64(resident) * sysconf(_SC_PAGESIZE) : 0;
+#else
+    return 0;
+#endif
+}
+
+// Показатели одного окна прогона
+struct SoakSample {
+    double simulatedHours;
+    qint64 rss;
+    qint64 footprint;
+    double allocationsPerTick;
+    double tickP50;
+    double tickP99;
+    double frameP50;
+    double frameP99;
+    int length;             ///< Длина змейки в конце окна
+    int maxLength;          ///< Наибольшая длина за окно
+    int restarts;           ///< Перезапусков после столкновения за окно
+};
+
+// Значение параметра командной строки "--name value"
+static double argumentValue(const QStringList &arguments, const QString &name, double defaultValue)
+{
+    const int index = arguments.indexOf(name);
+    if (index < 0 || index + 1 >= arguments.size()) return defaultValue;
+
+    bool ok = false;
+    const double value = arguments[index + 1].toDouble(&ok);
+    return ok ? value : defaultValue;
+}
+
+/**
+ * @brief Длительный безголовый прогон игры под управлением автопилота
+ *
+ * Каждое окно (по умолчанию 5 минут игрового времени) записывает RSS,
+ * число выделений памяти на такт, объем контейнеров состояния SnakeGame
+ * (включая сетку столкновений и буферы отрисовки), перцентили времени
+ * такта и кадра, длину змейки и число перезапусков. Первое окно - базовое;
+ * прогон завершается с кодом 1, если к концу RSS вырос больше порога,
+ * время, выделения или объем состояния ухудшились больше допустимого
+ * коэффициента или змейка ни разу не доросла до минимальной длины.
+ *
+ * Параметры:
+ *   --hours H               игровое время прогона (по умолчанию 1)
+ *   --sample-minutes M      длина окна в игровых минутах (5)
+ *   --max-rss-growth-mb N   допустимый рост RSS (32)
+ *   --max-time-drift K      допустимый рост p99 такта и кадра (1.5)
+ *   --max-alloc-drift K     допустимый рост выделений на такт (1.5)
+ *   --max-state-drift K     допустимый рост памяти состояния SnakeGame (1.5)
+ *   --min-length N          змейка должна хотя бы раз дорасти до N сегментов (30)
+ *   --report FILE           отчет в CSV
+ *   --software-render, --smooth-body, --fixed-point - как у snake_game
+ */
+int main(int argc, char *argv[])
+{
+    // Окно не показывается, поэтому платформа по умолчанию - offscreen
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    const QStringList arguments = app.arguments();
+
+    const double hours = argumentValue(arguments, "--hours", 1.0);
+    const double sampleMinutes = argumentValue(arguments, "--sample-minutes", 5.0);
+    const double maxRssGrowthMb = argumentValue(arguments, "--max-rss-growth-mb", 32.0);
+    const double maxTimeDrift = argumentValue(arguments, "--max-time-drift", 1.5);
+    const double maxAllocDrift = argumentValue(arguments, "--max-alloc-drift", 1.5);
+    const double maxStateDrift = argumentValue(arguments, "--max-state-drift", 1.5);
+    const int minLength = int(argumentValue(arguments, "--min-length", 30));
+
+    const qint64 ticksPerHour = 3600 * 1000 / SnakeGame::tickDelay();
+    const qint64 totalTicks = qMax<qint64>(1, qint64(hours * ticksPerHour));
+    const int ticksPerSample = qMax(1, int(sampleMinutes * 60 * 1000 / SnakeGame::tickDelay()));
+
+    SnakeGame game;
+    applyGameOptions(game, arguments);
+
+    // Буферы выделяются заранее, чтобы сам прогон не влиял на счетчики
+    QImage frame(game.size(), QImage::Format_ARGB32_Premultiplied);
+    FrameTimings timings;
+    timings.ticks.reserve(ticksPerSample);
+    timings.frames.reserve(ticksPerSample);
+    QVector<SoakSample> samples;
+    samples.reserve(int(totalTicks / ticksPerSample) + 1);
+
+    game.startHeadless(1);
+
+    std::printf("soak: %lld ticks (%.2f simulated hours), sample every %d ticks\n",
+                totalTicks, hours, ticksPerSample);
+    std::printf("%8s %10s %12s %12s %10s %10s %10s %10s %8s %8s %8s\n",
+                "hours", "rss MB", "state KB", "allocs/tick",
+                "tick p50", "tick p99", "frame p50", "frame p99",
+                "length", "max len", "restarts");
+
+    qint64 tick = 0;
+    int maxLength = 0;
+    while (tick < totalTicks) {
+        const int count = int(qMin<qint64>(ticksPerSample, totalTicks - tick));
+        const int windowRestarts = game.headlessRestarts();
+        const quint64 windowAllocations = g_allocations.load();
+        runTimedTicks(game, frame, count, timings);
+        const quint64 allocations = g_allocations.load();
+        tick += count;
+
+        SoakSample sample;
+        sample.simulatedHours = double(tick) / ticksPerHour;
+        sample.rss = residentMemory();
+        sample.footprint = game.stateFootprint();
+        sample.allocationsPerTick = double(allocations - windowAllocations) / count;
+        sample.tickP50 = percentileUs(timings.ticks, 0.50);
+        sample.tickP99 = percentileUs(timings.ticks, 0.99);
+        sample.frameP50 = percentileUs(timings.frames, 0.50);
+        sample.frameP99 = percentileUs(timings.frames, 0.99);
+        sample.length = game.snakeLength();
+        sample.maxLength = timings.maxLength;
+        sample.restarts = game.headlessRestarts() - windowRestarts;
+        samples.append(sample);
+        maxLength = qMax(maxLength, sample.maxLength);
+
+        std::printf("%8.2f %10.1f %12.1f %12.1f %10.1f %10.1f %10.1f %10.1f %8d %8d %8d\n",
+                    sample.simulatedHours, sample.rss / 1048576.0, sample.footprint / 1024.0,
+                    sample.allocationsPerTick, sample.tickP50, sample.tickP99,
+                    sample.frameP50, sample.frameP99,
+                    sample.length, sample.maxLength, sample.restarts);
+        std::fflush(stdout);
+
+        timings.ticks.clear();
+        timings.frames.clear();
+        timings.maxLength = 0;
+    }
+
+    // Отчет в CSV
+    const int reportIndex = arguments.indexOf("--report");
+    if (reportIndex >= 0 && reportIndex + 1 < arguments.size()) {
+        QFile report(arguments[reportIndex + 1]);
+        if (report.open(QIODevice::WriteOnly | QIODevice::Text)) {
+            QTextStream out(&report);
+            out << "hours,rss_bytes,state_bytes,allocs_per_tick,tick_p50_us,tick_p99_us,"
+                   "frame_p50_us,frame_p99_us,length,max_length,restarts\n";
+            for (const SoakSample &sample : samples) {
+                out << sample.simulatedHours << ',' << sample.rss << ',' << sample.footprint << ','
+                    << sample.allocationsPerTick << ',' << sample.tickP50 << ',' << sample.tickP99 << ','
+                    << sample.frameP50 << ',' << sample.frameP99 << ','
+                    << sample.length << ',' << sample.maxLength << ',' << sample.restarts << '\n';
+            }
+        } else {
+            std::fprintf(stderr, "soak: cannot write report %s\n", qPrintable(report.fileName()));
+        }
+    }
+
+    // Прогон на короткой змейке не проверяет рост и фрагментацию памяти
+    bool failed = maxLength < minLength;
+    std::printf("%-24s %10d (min %d) %s\n", "max length", maxLength, minLength, failed ? "FAIL" : "OK");
+
+    // Сравнение последнего окна с базовым
+    if (samples.size() < 2) {
+        std::printf("soak: not enough samples for regression checks\n");
+        return failed ? 1 : 0;
+    }
+
+    const SoakSample &first = samples.first();
+    const SoakSample &last = samples.last();
+
+    auto check = [&failed](const char *name, double value, double limit) {
+        const bool ok = value <= limit;
+        std::printf("%-24s %10.2f (limit %.2f) %s\n", name, value, limit, ok ? "OK" : "FAIL");
+        failed = failed || !ok;
+    };
+
+    // Малые абсолютные значения не дают осмысленного коэффициента
+    auto drift = [](double base, double value, double floor) {
+        return value / qMax(base, floor);
+    };
+
+    check("rss growth MB", (last.rss - first.rss) / 1048576.0, maxRssGrowthMb);
+    check("state drift", drift(first.footprint, last.footprint, 1.0), maxStateDrift);
+    check("tick p99 drift", drift(first.tickP99, last.tickP99, 1.0), maxTimeDrift);
+    check("frame p99 drift", drift(first.frameP99, last.frameP99, 1.0), maxTimeDrift);
+    check("allocs/tick drift", drift(first.allocationsPerTick, last.allocationsPerTick, 1.0), maxAllocDrift);
+
+    return failed ? 1 : 0;
+}
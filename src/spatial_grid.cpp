@@ -0,0 +1,66 @@
+#include "spatial_grid.h"
+#include <cmath>
+
+SpatialGrid::SpatialGrid() :
+    m_cellSize(1),
+    m_columns(0),
+    m_rows(0)
+{
+}
+
+void SpatialGrid::reset(const QRectF &bounds, qreal cellSize)
+{
+    m_bounds = bounds;
+    m_cellSize = cellSize;
+    m_columns = qMax(1, int(std::ceil(bounds.width() / cellSize)));
+    m_rows = qMax(1, int(std::ceil(bounds.height() / cellSize)));
+
+    // Ячейки очищаются без освобождения памяти, чтобы перезапуск игры не выделял ее заново
+    m_cells.resize(m_columns * m_rows);
+    for (QVector<int> &cell : m_cells) {
+        cell.clear();
+    }
+}
+
+void SpatialGrid::insert(int id, const QPointF &pos)
+{
+    m_cells[cellIndex(pos)].append(id);
+}
+
+void SpatialGrid::remove(int id, const QPointF &pos)
+{
+    QVector<int> &cell = m_cells[cellIndex(pos)];
+    const int index = cell.indexOf(id);
+    if (index < 0) return;
+
+    // Порядок в ячейке не важен: удаление перестановкой с последним
+    cell[index] = cell.last();
+    cell.removeLast();
+}
+
+void SpatialGrid::move(int id, const QPointF &from, const QPointF &to)
+{
+    if (cellIndex(from) == cellIndex(to)) return;
+
+    remove(id, from);
+    insert(id, to);
+}
+
+qint64 SpatialGrid::capacityBytes() const
+{
+    qint64 bytes = qint64(m_cells.capacity()) * sizeof(QVector<int>);
+    for (const QVector<int> &cell : m_cells) {
+        bytes += qint64(cell.capacity()) * sizeof(int);
+    }
+    return bytes;
+}
+
+int SpatialGrid::column(qreal x) const
+{
+    return qBound(0, int(std::floor((x - m_bounds.left()) / m_cellSize)), m_columns - 1);
+}
+
+int SpatialGrid::row(qreal y) const
+{
+    return qBound(0, int(std::floor((y - m_bounds.top()) / m_cellSize)), m_rows - 1);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <QPointF>
+#include <QRectF>
+#include <QVector>
+
+/**
+ * @class SpatialGrid
+ * @brief Равномерная сетка для быстрого поиска точек в прямоугольной области
+ *
+ * Хранит целочисленные идентификаторы точек по ячейкам. Точки за пределами
+ * границ попадают в крайние ячейки, поэтому поиск остается корректным
+ * и для сегментов в зоне телепортации.
+ */
+class SpatialGrid
+{
+public:
+    SpatialGrid();
+
+    void reset(const QRectF &bounds, qreal cellSize);   ///< Задает границы и очищает сетку
+    void insert(int id, const QPointF &pos);
+    void remove(int id, const QPointF &pos);
+    void move(int id, const QPointF &from, const QPointF &to);
+    qint64 capacityBytes() const;                       ///< Память, занятая ячейками (байт)
+
+    /**
+     * @brief Вызывает visit(id) для всех точек в ячейках, пересекающих область
+     *
+     * Ячейки могут содержать точки вне области - точную проверку делает вызывающий.
+     */
+    template <typename Visitor>
+    void query(const QRectF &area, Visitor visit) const
+    {
+        if (m_cells.isEmpty()) return;
+
+        const int left = column(area.left());
+        const int right = column(area.right());
+        const int top = row(area.top());
+        const int bottom = row(area.bottom());
+
+        for (int y = top; y <= bottom; y++) {
+            for (int x = left; x <= right; x++) {
+                for (int id : m_cells[y * m_columns + x]) {
+                    visit(id);
+                }
+            }
+        }
+    }
+
+private:
+    int column(qreal x) const;
+    int row(qreal y) const;
+    int cellIndex(const QPointF &pos) const { return row(pos.y()) * m_columns + column(pos.x()); }
+
+    QRectF m_bounds;                    ///< Область, покрытая ячейками
+    qreal m_cellSize;                   ///< Сторона ячейки
+    int m_columns;                      ///< Количество столбцов
+    int m_rows;                         ///< Количество строк
+    QVector<QVector<int>> m_cells;      ///< Идентификаторы точек по ячейкам
+};
@@ -0,0 +1,99 @@
+#include "sprite_blitter.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SNAKE_BLITTER_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+/**
+ * @brief Смешивает один пиксель (скалярный вариант)
+ *
+ * Деление на 255 выполняется с округлением: (t + 128 + ((t + 128) >> 8)) >> 8,
+ * так же, как в SSE2-ветке, чтобы обе ветки давали одинаковый результат.
+ */
+inline quint32 blendPixel(quint32 dst, quint32 src)
+{
+    const quint32 alpha = src >> 24;
+    if (alpha == 255) return src;
+    if (alpha == 0) return dst;
+
+    const quint32 inv = 255 - alpha;
+
+    quint32 rb = (dst & 0x00ff00ff) * inv + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+
+    quint32 ag = ((dst >> 8) & 0x00ff00ff) * inv + 0x00800080;
+    ag = ((ag + ((ag >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+
+    return src + (rb | (ag << 8));
+}
+
+} // namespace
+
+void SpriteBlitter::blendScanline(quint32 *dst, const quint32 *src, int count)
+{
+    int i = 0;
+
+#ifdef SNAKE_BLITTER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i opaque = _mm_set1_epi32(255);
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        const __m128i alpha = _mm_srli_epi32(s, 24);
+
+        // Быстрые пути: 4 прозрачных или 4 непрозрачных пикселя
+        const int transparentMask = _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero));
+        if (transparentMask == 0xffff) continue;
+
+        __m128i *d = reinterpret_cast<__m128i *>(dst + i);
+        const int opaqueMask = _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, opaque));
+        if (opaqueMask == 0xffff) {
+            _mm_storeu_si128(d, s);
+            continue;
+        }
+
+        // Обратная альфа, размноженная на 4 канала каждого пикселя (16 бит на канал)
+        const __m128i inv = _mm_sub_epi16(full, _mm_or_si128(alpha, _mm_slli_epi32(alpha, 16)));
+        const __m128i invLo = _mm_unpacklo_epi32(inv, inv);
+        const __m128i invHi = _mm_unpackhi_epi32(inv, inv);
+
+        const __m128i pixels = _mm_loadu_si128(d);
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(pixels, zero), invLo), half);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(pixels, zero), invHi), half);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+        _mm_storeu_si128(d, _mm_adds_epu8(s, _mm_packus_epi16(lo, hi)));
+    }
+#endif
+
+    for (; i < count; i++) {
+        dst[i] = blendPixel(dst[i], src[i]);
+    }
+}
+
+void SpriteBlitter::blend(QImage &target, const QImage &sprite, int x, int y)
+{
+    Q_ASSERT(target.format() == QImage::Format_ARGB32_Premultiplied);
+    Q_ASSERT(sprite.format() == QImage::Format_ARGB32_Premultiplied);
+
+    // Отсечение спрайта по границам кадра
+    const int left = qMax(0, -x);
+    const int top = qMax(0, -y);
+    const int right = qMin(sprite.width(), target.width() - x);
+    const int bottom = qMin(sprite.height(), target.height() - y);
+
+    if (left >= right || top >= bottom) return;
+
+    const int count = right - left;
+    for (int row = top; row < bottom; row++) {
+        const quint32 *src = reinterpret_cast<const quint32 *>(sprite.constScanLine(row)) + left;
+        quint32 *dst = reinterpret_cast<quint32 *>(target.scanLine(y + row)) + x + left;
+        blendScanline(dst, src, count);
+    }
+}
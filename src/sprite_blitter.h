@@ -0,0 +1,33 @@
+#pragma once
+
+#include <QImage>
+
+/**
+ * @class SpriteBlitter
+ * @brief Программный блиттер спрайтов для альтернативного бэкенда отрисовки
+ *
+ * Накладывает спрайты на кадр в формате ARGB32_Premultiplied напрямую через
+ * строки развертки, без QPainter. Смешивание выполняется по формуле
+ * "source over": dst = src + dst * (255 - srcAlpha) / 255.
+ * При наличии SSE2 обрабатываются по 4 пикселя за итерацию.
+ */
+class SpriteBlitter
+{
+public:
+    /**
+     * @brief Накладывает спрайт на кадр с отсечением по границам
+     * @param target Кадр (Format_ARGB32_Premultiplied)
+     * @param sprite Спрайт (Format_ARGB32_Premultiplied)
+     * @param x Координата левого края спрайта в кадре
+     * @param y Координата верхнего края спрайта в кадре
+     */
+    static void blend(QImage &target, const QImage &sprite, int x, int y);
+
+    /**
+     * @brief Смешивает одну строку пикселей
+     * @param dst Строка кадра
+     * @param src Строка спрайта
+     * @param count Количество пикселей
+     */
+    static void blendScanline(quint32 *dst, const quint32 *src, int count);
+};